@@ -18,6 +18,7 @@
 #include "agent.hpp"
 
 #include <boost/algorithm/string.hpp>
+#include <boost/asio/bind_executor.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/range/adaptor/sliced.hpp>
 #include <boost/range/adaptors.hpp>
@@ -50,6 +51,7 @@
 #include "entity/xml_parser.hpp"
 #include "logging.hpp"
 #include "observation/observation.hpp"
+#include "printer/cbor_printer.hpp"
 #include "printer/json_printer.hpp"
 #include "printer/xml_printer.hpp"
 #include "sink/rest_sink/file_cache.hpp"
@@ -81,6 +83,8 @@ namespace mtconnect {
       m_deviceXmlPath(deviceXmlPath),
       m_circularBuffer(GetOption<int>(options, config::BufferSize).value_or(17),
                        GetOption<int>(options, config::CheckpointFrequency).value_or(1000)),
+      m_ingestQueue([this](observation::ObservationList &batch) { addToBuffer(batch); }),
+      m_sinkMetricsTimer(context),
       m_pretty(GetOption<bool>(options, mtconnect::configuration::Pretty).value_or(false))
   {
     using namespace asset;
@@ -103,6 +107,7 @@ namespace mtconnect {
     // Create the Printers
     m_printers["xml"] = make_unique<printer::XmlPrinter>(m_pretty);
     m_printers["json"] = make_unique<printer::JsonPrinter>(jsonVersion, m_pretty);
+    m_printers["cbor"] = make_unique<printer::CborPrinter>(jsonVersion);
 
     if (m_schemaVersion)
     {
@@ -193,6 +198,9 @@ namespace mtconnect {
       // Start all the sources
       for (auto source : m_sources)
         source->start();
+
+      if (m_agentDevice)
+        scheduleSinkMetrics();
     }
     catch (std::runtime_error &e)
     {
@@ -211,6 +219,7 @@ namespace mtconnect {
       source->stop();
 
     LOG(info) << "Shutting down sinks";
+    m_sinkMetricsTimer.cancel();
     for (auto sink : m_sinks)
       sink->stop();
 
@@ -230,12 +239,25 @@ namespace mtconnect {
   // Pipeline methods
   // ---------------------------------------
   void Agent::receiveObservation(observation::ObservationPtr observation)
+  {
+    m_ingestQueue.push(observation);
+  }
+
+  void Agent::receiveObservations(const observation::ObservationList &observations)
+  {
+    m_ingestQueue.push(observations);
+  }
+
+  void Agent::addToBuffer(observation::ObservationList &observations)
   {
     std::lock_guard<buffer::CircularBuffer> lock(m_circularBuffer);
-    if (m_circularBuffer.addToBuffer(observation) != 0)
+    for (auto &observation : observations)
     {
-      for (auto &sink : m_sinks)
-        sink->publish(observation);
+      if (m_circularBuffer.addToBuffer(observation) != 0)
+      {
+        for (auto &sink : m_sinks)
+          sink->deliver(observation);
+      }
     }
   }
 
@@ -409,7 +431,10 @@ namespace mtconnect {
         // Replace device in device maps
         auto it = find(m_deviceIndex.begin(), m_deviceIndex.end(), oldDev);
         if (it != m_deviceIndex.end())
+        {
           m_deviceIndex.replace(it, device);
+          m_deviceGeneration++;
+        }
         else
         {
           LOG(error) << "Cannot find Device " << *uuid << " in devices";
@@ -609,6 +634,12 @@ namespace mtconnect {
         LOG(fatal) << "Error creating the agent device: " << e->what();
       throw EntityError("Cannot create AgentDevice");
     }
+
+    // Sinks are added before the agent is initialized
+    for (auto &sink : m_sinks)
+      if (sink->getQueue())
+        m_agentDevice->addSinkQueue(sink->getName());
+
     addDevice(m_agentDevice);
   }
 
@@ -754,6 +785,8 @@ namespace mtconnect {
         m_dataItemMap[d->getId()] = d;
       }
     }
+
+    m_deviceGeneration++;
   }
 
   // Add the a device from a configuration file
@@ -779,6 +812,7 @@ namespace mtconnect {
       // if (!m_initialized)
       {
         m_deviceIndex.push_back(device);
+        m_deviceGeneration++;
 
         // TODO: Redo Resolve Reference  with entity
         // device->resolveReferences();
@@ -829,6 +863,7 @@ namespace mtconnect {
 
     if (changed)
     {
+      m_deviceGeneration++;
       versionDeviceXml();
       loadCachedProbe();
 
@@ -943,6 +978,57 @@ namespace mtconnect {
 
     if (start)
       sink->start();
+
+    if (m_agentDevice && sink->getQueue())
+    {
+      m_agentDevice->addSinkQueue(sink->getName());
+
+      if (m_observationsInitialized)
+        initializeDataItems(m_agentDevice);
+
+      // Reload the document for path resolution
+      if (m_initialized)
+      {
+        loadCachedProbe();
+      }
+    }
+  }
+
+  void Agent::publishSinkMetrics()
+  {
+    if (!m_agentDevice)
+      return;
+
+    for (auto &sink : m_sinks)
+    {
+      auto &queue = sink->getQueue();
+      if (!queue)
+        continue;
+
+      auto publish = [this, &sink](const char *suffix, size_t value) {
+        auto di = m_agentDevice->getDeviceDataItem(sink->getName() + suffix);
+        if (di)
+          m_loopback->receive(di, {{"VALUE", double(value)}});
+      };
+
+      publish("_queue_depth", queue->size());
+      publish("_queue_high_water", queue->getHighWater());
+      publish("_queue_dropped", queue->getDropped());
+      publish("_queue_coalesced", queue->getCoalesced());
+    }
+  }
+
+  void Agent::scheduleSinkMetrics()
+  {
+    m_sinkMetricsTimer.expires_after(std::chrono::seconds(10));
+    m_sinkMetricsTimer.async_wait(
+        boost::asio::bind_executor(m_strand, [this](boost::system::error_code ec) {
+          if (!ec)
+          {
+            publishSinkMetrics();
+            scheduleSinkMetrics();
+          }
+        }));
   }
 
   void AgentPipelineContract::deliverConnectStatus(entity::EntityPtr entity,
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <boost/asio/steady_timer.hpp>
 #include <boost/multi_index/composite_key.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/identity.hpp>
@@ -26,6 +27,7 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <list>
 #include <map>
@@ -39,6 +41,7 @@
 #include "asset/asset_buffer.hpp"
 #include "buffer/checkpoint.hpp"
 #include "buffer/circular_buffer.hpp"
+#include "buffer/ingest_queue.hpp"
 #include "configuration/service.hpp"
 #include "device_model/agent_device.hpp"
 #include "device_model/device.hpp"
@@ -129,6 +132,9 @@ namespace mtconnect {
     const auto &getSources() const { return m_sources; }
     const auto &getSinks() const { return m_sinks; }
 
+    // Publish the queue metrics of the sinks with queues to the agent device
+    void publishSinkMetrics();
+
     const auto &getSchemaVersion() const { return m_schemaVersion; }
 
     // Get device from device map
@@ -170,6 +176,9 @@ namespace mtconnect {
     void receiveCommand(const std::string &device, const std::string &command,
                         const std::string &value, const std::string &source);
 
+    // Incremented whenever devices or their data items are added or changed
+    uint64_t getDeviceGeneration() const { return m_deviceGeneration; }
+
     DataItemPtr getDataItemForDevice(const std::string &deviceName,
                                      const std::string &dataItemName) const
     {
@@ -188,6 +197,7 @@ namespace mtconnect {
 
     // Pipeline methods
     void receiveObservation(observation::ObservationPtr observation);
+    void receiveObservations(const observation::ObservationList &observations);
     void receiveAsset(asset::AssetPtr asset);
     bool receiveDevice(device_model::DevicePtr device, bool version = true);
     bool removeAsset(DevicePtr device, const std::string &id,
@@ -223,6 +233,7 @@ namespace mtconnect {
 
     // Initialization methods
     void createAgentDevice();
+    void scheduleSinkMetrics();
     std::list<device_model::DevicePtr> loadXMLDeviceFile(const std::string &config);
     void verifyDevice(DevicePtr device);
     void initializeDataItems(DevicePtr device,
@@ -233,6 +244,9 @@ namespace mtconnect {
     // Asset count management
     void updateAssetCounts(const DevicePtr &device, const std::optional<std::string> type);
 
+    // Sequences a batch of observations into the buffer and publishes them to the sinks
+    void addToBuffer(observation::ObservationList &observations);
+
     observation::ObservationPtr getLatest(const std::string &id)
     {
       return m_circularBuffer.getLatest().getObservation(id);
@@ -296,6 +310,7 @@ namespace mtconnect {
 
     DeviceIndex m_deviceIndex;
     std::unordered_map<std::string, WeakDataItemPtr> m_dataItemMap;
+    std::atomic<uint64_t> m_deviceGeneration {0};
 
     // Xml Config
     std::optional<std::string> m_schemaVersion;
@@ -305,6 +320,12 @@ namespace mtconnect {
     // Circular Buffer
     buffer::CircularBuffer m_circularBuffer;
 
+    // Merges the observations from the adapter pipelines into the buffer
+    buffer::IngestQueue m_ingestQueue;
+
+    // Publishes the sink queue metrics every 10 seconds
+    boost::asio::steady_timer m_sinkMetricsTimer;
+
     // For debugging
     bool m_pretty;
   };
@@ -328,6 +349,10 @@ namespace mtconnect {
       }
       return nullptr;
     }
+    std::optional<uint64_t> deviceGeneration() const override
+    {
+      return m_agent->getDeviceGeneration();
+    }
     void eachDataItem(EachDataItem fun) override
     {
       for (auto &di : m_agent->m_dataItemMap)
@@ -341,6 +366,10 @@ namespace mtconnect {
     {
       m_agent->receiveObservation(obs);
     }
+    void deliverObservations(const observation::ObservationList &observations) override
+    {
+      m_agent->receiveObservations(observations);
+    }
     void deliverAsset(asset::AssetPtr asset) override { m_agent->receiveAsset(asset); }
     void deliverAssetCommand(entity::EntityPtr command) override;
     void deliverConnectStatus(entity::EntityPtr, const StringList &devices,
@@ -0,0 +1,120 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+
+#include "observation/observation.hpp"
+
+namespace mtconnect::buffer {
+  // A bounded multi-producer queue that merges observations from the adapter pipelines
+  // into the circular buffer. Producers append under a short lock and then try to become
+  // the sequencer. The sequencer takes everything that has been queued and hands it to
+  // the drain function as a single batch, so each producer's observations stay in order
+  // and the buffer is locked once per batch.
+  //
+  // If another thread is already sequencing, the producer returns and the sequencer
+  // picks up its observations. When the queue is full the producer waits for the
+  // sequencer to finish and drains the queue itself.
+  class IngestQueue
+  {
+  public:
+    using Drain = std::function<void(observation::ObservationList &)>;
+
+    IngestQueue(Drain drain, size_t capacity = 4096)
+      : m_drain(std::move(drain)), m_capacity(capacity)
+    {}
+
+    void push(observation::ObservationPtr observation)
+    {
+      bool full;
+      {
+        std::lock_guard<std::mutex> lock(m_queueLock);
+        m_queue.emplace_back(std::move(observation));
+        full = m_queue.size() >= m_capacity;
+      }
+      drain(full);
+    }
+
+    void push(const observation::ObservationList &observations)
+    {
+      if (observations.empty())
+        return;
+
+      bool full;
+      {
+        std::lock_guard<std::mutex> lock(m_queueLock);
+        m_queue.insert(m_queue.end(), observations.begin(), observations.end());
+        full = m_queue.size() >= m_capacity;
+      }
+      drain(full);
+    }
+
+    size_t size() const
+    {
+      std::lock_guard<std::mutex> lock(m_queueLock);
+      return m_queue.size();
+    }
+    size_t getCapacity() const { return m_capacity; }
+
+  protected:
+    void drain(bool wait)
+    {
+      // The sequencer lock is recursive since a sink may feed the loopback pipeline while
+      // the batch is being delivered.
+      std::unique_lock<std::recursive_mutex> sequencer(m_sequencerLock, std::defer_lock);
+      if (wait)
+        sequencer.lock();
+      else if (!sequencer.try_lock())
+        return;
+
+      while (true)
+      {
+        observation::ObservationList batch;
+        {
+          std::lock_guard<std::mutex> lock(m_queueLock);
+          batch.swap(m_queue);
+        }
+
+        if (!batch.empty())
+          m_drain(batch);
+
+        sequencer.unlock();
+
+        // A producer may have queued observations after the batch was taken and given up
+        // because this thread was sequencing. Take them if no one else has.
+        {
+          std::lock_guard<std::mutex> lock(m_queueLock);
+          if (m_queue.empty())
+            return;
+        }
+        if (!sequencer.try_lock())
+          return;
+      }
+    }
+
+  protected:
+    Drain m_drain;
+    size_t m_capacity;
+
+    mutable std::mutex m_queueLock;
+    observation::ObservationList m_queue;
+    std::recursive_mutex m_sequencerLock;
+  };
+}  // namespace mtconnect::buffer
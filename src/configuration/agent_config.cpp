@@ -667,7 +667,10 @@ namespace mtconnect::configuration {
                 {configuration::TlsVerifyClientCertificate, false},
                 {configuration::TlsClientCAs, ""s},
                 {configuration::SuppressIPAddress, false},
-                {configuration::AllowPutFrom, ""s}});
+                {configuration::AllowPutFrom, ""s},
+                {configuration::MaxRequestRate, 0.0},
+                {configuration::MaxRequestBurst, 10},
+                {configuration::MaxSampleCount, 0}});
 
     m_workerThreadCount = *GetOption<int>(options, configuration::WorkerThreads);
     m_monitorFiles = *GetOption<bool>(options, configuration::MonitorConfigFiles);
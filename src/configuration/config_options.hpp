@@ -37,6 +37,9 @@ namespace mtconnect {
     DECLARE_CONFIGURATION(MaxAssets);
     DECLARE_CONFIGURATION(MaxCachedFileSize);
     DECLARE_CONFIGURATION(MinCompressFileSize);
+    DECLARE_CONFIGURATION(MaxRequestBurst);
+    DECLARE_CONFIGURATION(MaxRequestRate);
+    DECLARE_CONFIGURATION(MaxSampleCount);
     DECLARE_CONFIGURATION(MinimumConfigReloadAge);
     DECLARE_CONFIGURATION(MonitorConfigFiles);
     DECLARE_CONFIGURATION(MonitorInterval);
@@ -71,6 +74,10 @@ namespace mtconnect {
     DECLARE_CONFIGURATION(MqttUserName);
     DECLARE_CONFIGURATION(MqttPassword);
 
+    // Sink Configuration
+    DECLARE_CONFIGURATION(SinkQueuePolicy);
+    DECLARE_CONFIGURATION(SinkQueueSize);
+
     // Adapter Configuration
     DECLARE_CONFIGURATION(AdapterIdentity);
     DECLARE_CONFIGURATION(AdditionalDevices);
@@ -84,6 +91,8 @@ namespace mtconnect {
     DECLARE_CONFIGURATION(IgnoreTimestamps);
     DECLARE_CONFIGURATION(LegacyTimeout);
     DECLARE_CONFIGURATION(Manufacturer);
+    DECLARE_CONFIGURATION(MaxCount);
+    DECLARE_CONFIGURATION(MaxPartSize);
     DECLARE_CONFIGURATION(Path);
     DECLARE_CONFIGURATION(PollingInterval);
     DECLARE_CONFIGURATION(PreserveUUID);
@@ -99,6 +108,7 @@ namespace mtconnect {
     DECLARE_CONFIGURATION(Topics);
     DECLARE_CONFIGURATION(UUID);
     DECLARE_CONFIGURATION(UpcaseDataItemValue);
+    DECLARE_CONFIGURATION(UpstreamFormat);
     DECLARE_CONFIGURATION(Url);
     DECLARE_CONFIGURATION(UsePolling);
 
@@ -132,6 +132,17 @@ namespace mtconnect {
         comp->addDataItem(di, errors);
       }
 
+      if (adapter->reportsLag())
+      {
+        ErrorList errors;
+        auto di = DataItem::make({{"type", "OBSERVATION_LAG"s},
+                                  {"id", id + "_observation_lag"s},
+                                  {"units", "COUNT"s},
+                                  {"category", "SAMPLE"s}},
+                                 errors);
+        comp->addDataItem(di, errors);
+      }
+
       {
         ErrorList errors;
         auto di = DataItem::make({{"type", "ADAPTER_SOFTWARE_VERSION"s},
@@ -151,6 +162,30 @@ namespace mtconnect {
       }
     }
 
+    void AgentDevice::addSinkQueue(const std::string &sink)
+    {
+      using namespace entity;
+      using namespace device_model::data_item;
+
+      static const pair<const char *, const char *> metrics[] {
+          {"depth", "SINK_QUEUE_DEPTH"},
+          {"high_water", "SINK_QUEUE_HIGH_WATER"},
+          {"dropped", "SINK_QUEUE_DROPPED"},
+          {"coalesced", "SINK_QUEUE_COALESCED"}};
+      for (auto &[suffix, type] : metrics)
+      {
+        auto id = sink + "_queue_" + suffix;
+        if (getDeviceDataItem(id))
+          continue;
+
+        ErrorList errors;
+        auto di = DataItem::make(
+            {{"type", string(type)}, {"id", id}, {"units", "COUNT"s}, {"category", "SAMPLE"s}},
+            errors);
+        addDataItem(di, errors);
+      }
+    }
+
     void AgentDevice::addRequiredDataItems()
     {
       using namespace entity;
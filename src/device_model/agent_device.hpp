@@ -47,6 +47,8 @@ namespace mtconnect {
       }
 
       void addAdapter(const source::adapter::AdapterPtr adapter);
+      // Queue depth, high water, dropped and coalesced counts for a sink with a queue
+      void addSinkQueue(const std::string &sink);
 
       DataItemPtr getConnectionStatus(const std::string &adapter)
       {
@@ -24,6 +24,11 @@
 
 #include "entity/requirement.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MTCONNECT_CONVERT_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace mtconnect {
   namespace device_model {
     namespace data_item {
@@ -40,16 +45,28 @@ namespace mtconnect {
 
         entity::Vector convert(const entity::Vector &value) const
         {
-          entity::Vector res(value.size());
-          for (size_t i = 0; i < value.size(); i++)
-            res[i] = convert(value[i]);
-
+          entity::Vector res(value);
+          convert(res);
           return res;
         }
-        void convert(entity::Vector &value) const
+        void convert(entity::Vector &value) const { convert(value.data(), value.size()); }
+
+        // Convert the values in place, two at a time with SSE2. The results are the same as
+        // converting each value.
+        void convert(double *values, size_t count) const
         {
-          for (size_t i = 0; i < value.size(); i++)
-            value[i] = convert(value[i]);
+          size_t i = 0;
+#ifdef MTCONNECT_CONVERT_SSE2
+          const auto offset = _mm_set1_pd(m_offset);
+          const auto factor = _mm_set1_pd(m_factor);
+          for (; i + 2 <= count; i += 2)
+          {
+            auto v = _mm_loadu_pd(values + i);
+            _mm_storeu_pd(values + i, _mm_mul_pd(_mm_add_pd(v, offset), factor));
+          }
+#endif
+          for (; i < count; i++)
+            values[i] = convert(values[i]);
         }
         entity::Value convertValue(const entity::Value &value)
         {
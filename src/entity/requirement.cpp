@@ -179,18 +179,9 @@ namespace mtconnect {
       }
       void operator()(const string &arg, Timestamp &ts)
       {
-        istringstream in(arg);
-
-        // If there isa a time portion in the string, parse the time
-        if (arg.find('T') != string::npos)
-        {
-          in >> std::setw(6) >> date::parse("%FT%T", ts);
-        }
-        else
-        {
-          // Just parse the date
-          in >> date::parse("%F", ts);
-        }
+        // Parses the time if there is one, otherwise just the date
+        if (auto parsed = parseTimestamp(arg))
+          ts = *parsed;
       }
       void operator()(const string &arg, Vector &r)
       {
@@ -277,10 +268,13 @@ namespace mtconnect {
       {
         if (arg.size() > 0)
         {
-          stringstream s;
-          for (auto &v : arg)
-            s << formatted(v) << ' ';
-          v = string_view(s.str().c_str(), s.str().size() - 1);
+          v.reserve(arg.size() * 8);
+          for (auto &d : arg)
+          {
+            if (!v.empty())
+              v.push_back(' ');
+            appendDouble(v, d);
+          }
         }
       }
       template <typename T>
@@ -0,0 +1,77 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#pragma once
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MTCONNECT_SCAN_SSE2 1
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace mtconnect::pipeline {
+  // Finds the first occurrence of any character in the set. Compares 16 bytes at a time
+  // with SSE2 when the target has it and falls back to a byte at a time scan otherwise.
+  template <char... Cs>
+  struct CharScanner
+  {
+    static inline bool matches(const char c) { return ((c == Cs) || ...); }
+
+    // Returns end if none of the characters are found.
+    static inline const char *findScalar(const char *p, const char *end)
+    {
+      while (p < end && !matches(*p))
+        p++;
+      return p;
+    }
+
+    static inline const char *find(const char *p, const char *end)
+    {
+#ifdef MTCONNECT_SCAN_SSE2
+      while (end - p >= 16)
+      {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        auto hits = _mm_setzero_si128();
+        ((hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(Cs)))), ...);
+        auto mask = static_cast<unsigned int>(_mm_movemask_epi8(hits));
+        if (mask != 0)
+          return p + firstBit(mask);
+        p += 16;
+      }
+#endif
+      return findScalar(p, end);
+    }
+
+  protected:
+#ifdef MTCONNECT_SCAN_SSE2
+    static inline unsigned int firstBit(unsigned int mask)
+    {
+#ifdef _MSC_VER
+      unsigned long index;
+      _BitScanForward(&index, mask);
+      return static_cast<unsigned int>(index);
+#else
+      return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+    }
+#endif
+  };
+}  // namespace mtconnect::pipeline
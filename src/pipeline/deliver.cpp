@@ -51,6 +51,29 @@ namespace mtconnect {
       return entity;
     }
 
+    void DeliverObservation::run(const EntityList &entities, EntityList &results)
+    {
+      using namespace observation;
+      ObservationList observations;
+      for (const auto &entity : entities)
+      {
+        auto o = std::dynamic_pointer_cast<Observation>(entity);
+        if (!o)
+        {
+          LOG(error) << "Unexpected entity type, cannot convert to observation in "
+                        "DeliverObservation";
+          continue;
+        }
+        observations.emplace_back(o);
+      }
+
+      // Deliver the batch together so it is added to the buffer under a single lock.
+      m_contract->deliverObservations(observations);
+      (*m_count) += observations.size();
+
+      results.insert(results.end(), observations.begin(), observations.end());
+    }
+
     void ComputeMetrics::start()
     {
       m_timer.cancel();
@@ -118,6 +118,7 @@ namespace mtconnect {
         m_guard = TypeGuard<observation::Observation>(RUN);
       }
       const entity::EntityPtr operator()(const entity::EntityPtr entity) override;
+      void run(const entity::EntityList &entities, entity::EntityList &results) override;
     };
 
     class DeliverAsset : public MeteredTransform
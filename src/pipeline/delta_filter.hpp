@@ -26,10 +26,7 @@ namespace mtconnect {
     class DeltaFilter : public Transform
     {
     public:
-      struct State : TransformState
-      {
-        std::unordered_map<std::string, double> m_lastSampleValue;
-      };
+      using State = PartitionedState<double>;
 
       DeltaFilter(PipelineContextPtr context)
         : Transform("RateFilter"),
@@ -48,37 +45,63 @@ namespace mtconnect {
 
       const entity::EntityPtr operator()(const entity::EntityPtr entity) override
       {
-        using namespace std;
-        using namespace observation;
-        using namespace entity;
+        if (filtered(entity))
+          return entity::EntityPtr();
+
+        return next(entity);
+      }
 
-        std::lock_guard<TransformState> guard(*m_state);
+      void run(const entity::EntityList &entities, entity::EntityList &results) override
+      {
+        entity::EntityList passed;
+        for (const auto &entity : entities)
+        {
+          try
+          {
+            if (!filtered(entity))
+              passed.emplace_back(entity);
+          }
+          catch (entity::EntityError &e)
+          {
+            LOG(error) << m_name << ": dropping " << entity->getName() << ": " << e.what();
+          }
+        }
+
+        next(passed, results);
+      }
+
+    protected:
+      // Only the partition for the data item is locked.
+      bool filtered(const entity::EntityPtr &entity)
+      {
+        using namespace observation;
 
         auto o = std::dynamic_pointer_cast<Observation>(entity);
         if (o->isOrphan())
-          return EntityPtr();
+          return true;
         auto di = o->getDataItem();
         auto &id = di->getId();
 
+        auto &partition = m_state->partition(id);
+        std::lock_guard<std::mutex> guard(partition.m_mutex);
+
         if (o->isUnavailable())
         {
-          m_state->m_lastSampleValue.erase(id);
-          return next(entity);
+          partition.m_values.erase(id);
+          return false;
         }
 
         auto filter = *di->getMinimumDelta();
         double value = o->getValue<double>();
-        if (filterMinimumDelta(id, value, filter))
-          return EntityPtr();
-
-        return next(entity);
+        return filterMinimumDelta(partition.m_values, id, value, filter);
       }
 
-    protected:
-      bool filterMinimumDelta(const std::string &id, const double value, const double fv)
+
+      bool filterMinimumDelta(std::unordered_map<std::string, double> &values,
+                              const std::string &id, const double value, const double fv)
       {
-        auto last = m_state->m_lastSampleValue.find(id);
-        if (last != m_state->m_lastSampleValue.end())
+        auto last = values.find(id);
+        if (last != values.end())
         {
           double lv = last->second;
           if (value > (lv - fv) && value < (lv + fv))
@@ -89,7 +112,7 @@ namespace mtconnect {
         }
         else
         {
-          m_state->m_lastSampleValue[id] = value;
+          values[id] = value;
         }
 
         return false;
@@ -24,10 +24,7 @@ namespace mtconnect {
     class DuplicateFilter : public Transform
     {
     public:
-      struct State : TransformState
-      {
-        std::unordered_map<std::string, entity::Value> m_values;
-      };
+      using State = PartitionedState<entity::Value>;
 
       DuplicateFilter(const DuplicateFilter &) = default;
       DuplicateFilter(PipelineContextPtr context)
@@ -45,28 +42,60 @@ namespace mtconnect {
       ~DuplicateFilter() override = default;
 
       const entity::EntityPtr operator()(const entity::EntityPtr entity) override
+      {
+        if (isDuplicate(entity))
+          return entity::EntityPtr();
+
+        return next(entity);
+      }
+
+      void run(const entity::EntityList &entities, entity::EntityList &results) override
+      {
+        entity::EntityList unique;
+        for (const auto &entity : entities)
+        {
+          try
+          {
+            if (!isDuplicate(entity))
+              unique.emplace_back(entity);
+          }
+          catch (entity::EntityError &e)
+          {
+            LOG(error) << m_name << ": dropping " << entity->getName() << ": " << e.what();
+          }
+        }
+
+        next(unique, results);
+      }
+
+    protected:
+      // Records the value if it is not a duplicate. Only the partition for the data
+      // item is locked.
+      bool isDuplicate(const entity::EntityPtr &entity)
       {
         using namespace observation;
-        std::lock_guard<TransformState> guard(*m_state);
 
         auto o = std::dynamic_pointer_cast<Observation>(entity);
         if (o->isOrphan())
-          return entity::EntityPtr();
+          return true;
 
         auto di = o->getDataItem();
         auto &id = di->getId();
 
-        auto &values = m_state->m_values;
+        auto &partition = m_state->partition(id);
+        std::lock_guard<std::mutex> guard(partition.m_mutex);
+
+        auto &values = partition.m_values;
         auto old = values.find(id);
         if (old != values.end() && old->second == o->getValue())
-          return entity::EntityPtr();
+          return true;
 
         if (old == values.end())
           values[id] = o->getValue();
         else
           old->second = o->getValue();
 
-        return next(entity);
+        return false;
       }
 
     protected:
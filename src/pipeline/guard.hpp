@@ -17,6 +17,12 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <typeinfo>
+
 #include "entity/entity.hpp"
 
 namespace mtconnect {
@@ -28,7 +34,106 @@ namespace mtconnect {
       SKIP
     };
 
-    using Guard = std::function<GuardAction(const entity::EntityPtr entity)>;
+    class GuardCls;
+
+    // Wraps the guard function. Guards built only from type and entity name checks are
+    // pure functions of the entity's dynamic type (and name), so their decisions are
+    // memoized in a small table that is read without locking. Guards containing a
+    // lambda or an arbitrary function are always evaluated, this includes the LambdaGuards
+    // of the duplicate, delta and period filters.
+    class Guard : public std::function<GuardAction(const entity::EntityPtr entity)>
+    {
+    public:
+      using Function = std::function<GuardAction(const entity::EntityPtr entity)>;
+
+      Guard() = default;
+      Guard(std::nullptr_t) {}
+      Guard(const Guard &other)
+        : Function(other), m_cacheable(other.m_cacheable), m_usesName(other.m_usesName)
+      {}
+      template <typename F, typename = std::enable_if_t<
+                                !std::is_same_v<std::decay_t<F>, Guard> &&
+                                std::is_invocable_r_v<GuardAction, F &, const entity::EntityPtr>>>
+      Guard(F f) : Function(f)
+      {
+        if constexpr (std::is_base_of_v<GuardCls, F>)
+        {
+          m_cacheable = f.isCacheable();
+          m_usesName = f.usesName();
+        }
+      }
+
+      Guard &operator=(const Guard &other)
+      {
+        Function::operator=(other);
+        m_cacheable = other.m_cacheable;
+        m_usesName = other.m_usesName;
+        m_count.store(0, std::memory_order_release);
+        return *this;
+      }
+
+      GuardAction operator()(const entity::EntityPtr entity) const
+      {
+        if (!m_cacheable || !s_cacheEnabled)
+          return Function::operator()(entity);
+
+        const auto &e = *entity;
+        const auto &type = typeid(e);
+        auto count = m_count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; i++)
+        {
+          const auto &entry = m_entries[i];
+          if (*entry.m_type == type && (!m_usesName || entry.m_name == entity->getName()))
+            return entry.m_action;
+        }
+
+        auto action = Function::operator()(entity);
+
+        // Once the table is full misses are evaluated without touching the lock
+        if (count == m_entries.size())
+          return action;
+
+        // Entries are only appended and never modified once published.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        count = m_count.load(std::memory_order_relaxed);
+        if (count < m_entries.size())
+        {
+          auto &entry = m_entries[count];
+          entry.m_type = &type;
+          if (m_usesName)
+            entry.m_name = entity->getName();
+          entry.m_action = action;
+          m_count.store(count + 1, std::memory_order_release);
+        }
+
+        return action;
+      }
+
+      bool isCacheable() const { return m_cacheable; }
+      bool usesName() const { return m_usesName; }
+
+      // Globally enable or disable memoization, used for benchmarking
+      static void enableCache(bool enable) { s_cacheEnabled = enable; }
+      static bool isCacheEnabled() { return s_cacheEnabled; }
+
+    protected:
+      struct Entry
+      {
+        const std::type_info *m_type {nullptr};
+        std::string m_name;
+        GuardAction m_action;
+      };
+
+      bool m_cacheable {false};
+      bool m_usesName {false};
+
+      mutable std::array<Entry, 16> m_entries;
+      mutable std::atomic<size_t> m_count {0};
+      mutable std::mutex m_mutex;
+
+      static inline bool s_cacheEnabled {true};
+    };
+
     class GuardCls
     {
     public:
@@ -39,6 +144,13 @@ namespace mtconnect {
 
       void setAlternative(Guard &alt) { m_alternative = alt; }
 
+      // True if the result only depends on the type and name of the entity
+      bool isCacheable() const
+      {
+        return m_cacheable && (!m_alternative || m_alternative.isCacheable());
+      }
+      bool usesName() const { return m_usesName || (m_alternative && m_alternative.usesName()); }
+
       GuardAction check(bool matched, const entity::EntityPtr entity)
       {
         if (matched)
@@ -58,6 +170,8 @@ namespace mtconnect {
     protected:
       Guard m_alternative;
       GuardAction m_match;
+      bool m_cacheable {true};
+      bool m_usesName {false};
     };
 
     template <typename... Ts>
@@ -125,7 +239,10 @@ namespace mtconnect {
     class EntityNameGuard : public GuardCls
     {
     public:
-      EntityNameGuard(const std::string &name, GuardAction match) : GuardCls(match), m_name(name) {}
+      EntityNameGuard(const std::string &name, GuardAction match) : GuardCls(match), m_name(name)
+      {
+        m_usesName = true;
+      }
 
       bool matches(const entity::EntityPtr &entity) { return entity->getName() == m_name; }
 
@@ -149,7 +266,10 @@ namespace mtconnect {
     public:
       using Lambda = std::function<bool(const L &)>;
 
-      LambdaGuard(Lambda guard, GuardAction match) : B(match), m_lambda(guard) {}
+      LambdaGuard(Lambda guard, GuardAction match) : B(match), m_lambda(guard)
+      {
+        B::m_cacheable = false;
+      }
       LambdaGuard(const LambdaGuard &) = default;
       ~LambdaGuard() = default;
 
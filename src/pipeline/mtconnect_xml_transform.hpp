@@ -30,8 +30,15 @@ namespace mtconnect::pipeline {
   {
     uint64_t m_instanceId = 0;
     SequenceNumber_t m_next = 0;
+    SequenceNumber_t m_last = 0;
     entity::EntityList m_assetEvents;
     ResponseDocument::Errors m_errors;
+
+    // Number of observations buffered upstream that have not been requested yet
+    SequenceNumber_t lag() const
+    {
+      return (m_next != 0 && m_last >= m_next) ? m_last - m_next + 1 : 0;
+    }
   };
 
   using namespace mtconnect::entity;
@@ -40,10 +47,12 @@ namespace mtconnect::pipeline {
   public:
     MTConnectXmlTransform(const MTConnectXmlTransform &) = default;
     MTConnectXmlTransform(PipelineContextPtr context, XmlTransformFeedback &feedback,
-                          const std::optional<std::string> &device = std::nullopt)
+                          const std::optional<std::string> &device = std::nullopt,
+                          const std::optional<std::string> &lagMetric = std::nullopt)
       : Transform("MTConnectXmlTransform"),
         m_context(context),
         m_defaultDevice(device),
+        m_lagMetric(lagMetric),
         m_feedback(feedback)
     {
       m_guard = EntityNameGuard("Data", RUN);
@@ -71,6 +80,7 @@ namespace mtconnect::pipeline {
 
       m_feedback.m_instanceId = rd.m_instanceId;
       m_feedback.m_next = rd.m_next;
+      m_feedback.m_last = rd.m_last;
       m_feedback.m_assetEvents = rd.m_assetEvents;
       m_feedback.m_errors = rd.m_errors;
 
@@ -79,6 +89,9 @@ namespace mtconnect::pipeline {
         throw std::system_error(make_error_code(ErrorCode::RESTART_STREAM));
       }
 
+      if (m_lagMetric)
+        deliverLag(m_feedback.lag());
+
       for (auto &entity : rd.m_entities)
       {
         next(entity);
@@ -87,9 +100,28 @@ namespace mtconnect::pipeline {
       return std::make_shared<Entity>("Entities", Properties {{"VALUE", rd.m_entities}});
     }
 
+  protected:
+    void deliverLag(SequenceNumber_t lag)
+    {
+      if (m_lastLag && *m_lastLag == lag)
+        return;
+
+      m_lastLag = lag;
+      auto di = m_context->m_contract->findDataItem("Agent", *m_lagMetric);
+      if (di)
+      {
+        ErrorList errors;
+        auto obs = observation::Observation::make(di, Properties {{"VALUE", double(lag)}},
+                                                  std::chrono::system_clock::now(), errors);
+        m_context->m_contract->deliverObservation(obs);
+      }
+    }
+
   protected:
     PipelineContextPtr m_context;
     std::optional<std::string> m_defaultDevice;
+    std::optional<std::string> m_lagMetric;
+    std::optional<SequenceNumber_t> m_lastLag;
     XmlTransformFeedback &m_feedback;
   };
 }  // namespace mtconnect::pipeline
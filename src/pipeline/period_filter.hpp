@@ -54,11 +54,7 @@ namespace mtconnect {
 
       using LastObservationMap = std::unordered_map<std::string, LastObservation>;
       using LastObservationIterator = LastObservationMap::iterator;
-
-      struct State : TransformState
-      {
-        LastObservationMap m_lastObservation;
-      };
+      using State = PartitionedState<LastObservation>;
 
       PeriodFilter(PipelineContextPtr context, boost::asio::io_context::strand &st)
         : Transform("PeriodFilter"),
@@ -82,29 +78,33 @@ namespace mtconnect {
         using namespace entity;
 
         auto obs = std::dynamic_pointer_cast<Observation>(entity);
-        {
-          std::lock_guard<TransformState> guard(*m_state);
+        if (obs->isOrphan())
+          return EntityPtr();
 
-          if (obs->isOrphan())
-            return EntityPtr();
+        auto di = obs->getDataItem();
+        auto &id = di->getId();
 
-          auto di = obs->getDataItem();
-          auto &id = di->getId();
+        {
+          // Only the partition for this data item is locked, the delayed send locks the same
+          // partition.
+          auto &partition = m_state->partition(id);
+          std::lock_guard<std::mutex> guard(partition.m_mutex);
+          auto &values = partition.m_values;
 
           if (obs->isUnavailable())
           {
-            m_state->m_lastObservation.erase(id);
+            values.erase(id);
           }
           else
           {
             auto ts = obs->getTimestamp();
 
-            auto last = m_state->m_lastObservation.find(id);
-            if (last == m_state->m_lastObservation.end())
+            auto last = values.find(id);
+            if (last == values.end())
             {
               auto period =
                   chrono::milliseconds(static_cast<int64_t>(*di->getMinimumPeriod() * 1000.0));
-              auto res = m_state->m_lastObservation.try_emplace(id, period, m_strand);
+              auto res = values.try_emplace(id, period, m_strand);
               if (res.second)
                 last = res.first;
               else
@@ -208,11 +208,12 @@ namespace mtconnect {
 
           ObservationPtr obs;
           {
-            std::lock_guard<TransformState> guard(*m_state);
+            auto &partition = m_state->partition(id);
+            std::lock_guard<std::mutex> guard(partition.m_mutex);
 
             // Find the entry for this data item and make sure there is an observation
-            auto last = m_state->m_lastObservation.find(id);
-            if (last != m_state->m_lastObservation.end() && last->second.m_observation)
+            auto last = partition.m_values.find(id);
+            if (last != partition.m_values.end() && last->second.m_observation)
             {
               last->second.m_observation.swap(obs);
               last->second.m_timestamp = obs->getTimestamp() + last->second.m_delta;
@@ -217,6 +217,12 @@ namespace mtconnect {
 
       const entity::EntityPtr run(const entity::EntityPtr entity) { return m_start->next(entity); }
 
+      // Run a batch of entities through the pipeline. The order of the entities is preserved.
+      void run(const entity::EntityList &entities, entity::EntityList &results)
+      {
+        m_start->next(entities, results);
+      }
+
       TransformPtr bind(TransformPtr transform)
       {
         m_start->bind(transform);
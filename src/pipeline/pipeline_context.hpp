@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -37,6 +38,26 @@ namespace mtconnect {
     };
     using TransformStatePtr = std::shared_ptr<TransformState>;
 
+    // Transform state partitioned by data item id. Each partition has its own mutex so
+    // pipelines sharing the context only contend when they update data items in the
+    // same partition.
+    template <typename T, size_t N = 64>
+    struct PartitionedState : TransformState
+    {
+      struct Partition
+      {
+        std::mutex m_mutex;
+        std::unordered_map<std::string, T> m_values;
+      };
+
+      Partition &partition(const std::string &id)
+      {
+        return m_partitions[std::hash<std::string>()(id) % N];
+      }
+
+      std::array<Partition, N> m_partitions;
+    };
+
     class PipelineContext : public std::enable_shared_from_this<PipelineContext>
     {
     public:
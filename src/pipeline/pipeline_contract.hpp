@@ -17,8 +17,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <list>
+#include <optional>
 #include <string>
 
 namespace mtconnect {
@@ -56,8 +58,16 @@ namespace mtconnect {
 
       virtual DevicePtr findDevice(const std::string &device) = 0;
       virtual DataItemPtr findDataItem(const std::string &device, const std::string &name) = 0;
+      // Changes whenever the devices or data items change so lookups can be cached. No
+      // value means the results of findDataItem cannot be cached.
+      virtual std::optional<uint64_t> deviceGeneration() const { return std::nullopt; }
       virtual void eachDataItem(EachDataItem fun) = 0;
       virtual void deliverObservation(observation::ObservationPtr) = 0;
+      virtual void deliverObservations(const std::list<observation::ObservationPtr> &observations)
+      {
+        for (auto &o : observations)
+          deliverObservation(o);
+      }
       virtual void deliverAsset(asset::AssetPtr) = 0;
       virtual void deliverDevice(DevicePtr device) = 0;
       virtual void deliverAssetCommand(entity::EntityPtr) = 0;
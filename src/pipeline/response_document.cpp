@@ -20,8 +20,10 @@
 #include <date/date.h>
 
 #include <libxml/parser.h>
+#include <libxml/xmlreader.h>
 #include <libxml/xpath.h>
 #include <libxml/xpathInternals.h>
+#include <nlohmann/json.hpp>
 
 #include "asset/asset.hpp"
 #include "device_model/device.hpp"
@@ -177,48 +179,16 @@ namespace mtconnect::pipeline {
       return lexical_cast<int64_t>(s);
   }
 
-  inline void dataSet(xmlNodePtr node, bool table, DataSet &ds)
-  {
-    eachElement(node, "Entry", [table, &ds](xmlNodePtr n) {
-      DataSetEntry entry;
-      entry.m_key = attributeValue(n, "key");
-      entry.m_removed = attributeValue(n, "removed", true) == "true";
-
-      if (table)
-      {
-        entry.m_value.emplace<DataSet>();
-        DataSet &row = get<DataSet>(entry.m_value);
-
-        eachElement(n, "Cell", [&row](xmlNodePtr c) {
-          row.emplace(attributeValue(c, "key"), type(text(c)));
-          return true;
-        });
-
-        if (row.empty())
-          entry.m_value.emplace<monostate>();
-      }
-      else
-      {
-        entry.m_value = type(text(n));
-      }
-
-      ds.insert(entry);
-      return true;
-    });
-  }
-
   inline static Timestamp parseTimestamp(const std::string value)
   {
-    Timestamp ts;
-    istringstream in(value);
-    in >> std::setw(6) >> date::parse("%FT%T", ts);
-    if (!in.good())
+    auto ts = mtconnect::parseTimestamp(value);
+    if (!ts)
     {
       LOG(error) << "Cound not parse XML timestamp: " << value;
-      ts = std::chrono::system_clock::now();
+      return std::chrono::system_clock::now();
     }
 
-    return ts;
+    return *ts;
   }
 
   inline static DataItemPtr findDataItem(const std::string &name, DevicePtr device,
@@ -257,119 +227,722 @@ namespace mtconnect::pipeline {
     return di;
   }
 
-  inline static bool parseObservations(ResponseDocument &out, xmlNodePtr node,
-                                       pipeline::PipelineContextPtr context,
-                                       const std::optional<std::string> &deviceName)
+  // The properties must have the VALUE
+  inline static void addObservation(ResponseDocument &out, const DevicePtr &device,
+                                    const DataItemPtr &di, Properties &properties)
   {
-    auto streams = findChild(node, "Streams");
-    if (streams == nullptr)
-      return false;
+    // Remove old properties
+    properties.erase("name");
+    properties.erase("dataItemId");
 
-    auto contract = context->m_contract.get();
+    Timestamp timestamp;
+    auto ts = properties.find("timestamp");
+    if (ts != properties.end() && holds_alternative<string>(ts->second))
+      timestamp = parseTimestamp(get<string>(ts->second));
+    else
+      timestamp = std::chrono::system_clock::now();
+
+    if (di->isAssetRemoved())
+    {
+      auto id = get_if<string>(&properties["VALUE"]);
+      if (id != nullptr && *id != "UNAVAILABLE")
+      {
+        auto ac = make_shared<pipeline::AssetCommand>(
+            "AssetCommand", Properties {{"assetId"s, *id},
+                                        {"device"s, *(device->getUuid())},
+                                        {"VALUE"s, "RemoveAsset"s}});
+        out.m_entities.emplace_back(ac);
+        return;
+      }
+    }
+
+    ErrorList errors;
+    auto obs = observation::Observation::make(di, properties, timestamp, errors);
+    if (!errors.empty())
+    {
+      for (auto &e : errors)
+      {
+        LOG(warning) << "Error while parsing response document: " << e->what();
+      }
+      return;
+    }
 
-    eachElement(streams, "DeviceStream", [&out, &contract, &deviceName](xmlNodePtr dev) {
-      DevicePtr device;
-      if (deviceName)
+    if (di->isAssetChanged())
+      out.m_assetEvents.emplace_back((obs));
+    else
+      out.m_entities.emplace_back(obs);
+  }
+
+  // Streams documents are read with an xmlTextReader so observations are created as the elements
+  // go by without building a DOM.
+  struct NoChildren
+  {
+    bool operator()(xmlTextReaderPtr) const { return false; }
+  };
+
+  inline static bool nameIs(xmlTextReaderPtr reader, const char *name)
+  {
+    return xmlStrcmp(xmlTextReaderConstLocalName(reader), BAD_CAST name) == 0;
+  }
+
+  template <typename F>
+  inline static void eachAttribute(xmlTextReaderPtr reader, F &&cb)
+  {
+    if (xmlTextReaderMoveToFirstAttribute(reader) == 1)
+    {
+      do
+      {
+        if (xmlTextReaderIsNamespaceDecl(reader) == 0)
+          cb((const char *)xmlTextReaderConstLocalName(reader),
+             (const char *)xmlTextReaderConstValue(reader));
+      } while (xmlTextReaderMoveToNextAttribute(reader) == 1);
+      xmlTextReaderMoveToElement(reader);
+    }
+  }
+
+  inline static string attributeValue(xmlTextReaderPtr reader, const char *name)
+  {
+    string res;
+    eachAttribute(reader, [name, &res](const char *attr, const char *value) {
+      if (strcmp(name, attr) == 0)
+        res = value;
+    });
+    return res;
+  }
+
+  // Reads up to the end of the current element. The first text child is trimmed into text and
+  // child elements are given to child, which must read them to their end or return false to
+  // have them skipped.
+  template <typename F = NoChildren>
+  inline static void readContent(xmlTextReaderPtr reader, string *text, F &&child = F())
+  {
+    if (xmlTextReaderIsEmptyElement(reader) == 1)
+      return;
+
+    auto depth = xmlTextReaderDepth(reader);
+    bool found = false;
+    while (xmlTextReaderRead(reader) == 1)
+    {
+      auto type = xmlTextReaderNodeType(reader);
+      if (type == XML_READER_TYPE_END_ELEMENT && xmlTextReaderDepth(reader) == depth)
       {
-        device = contract->findDevice(*deviceName);
-        if (!device)
+        break;
+      }
+      else if (type == XML_READER_TYPE_TEXT)
+      {
+        if (text != nullptr && !found)
         {
-          LOG(warning) << "Parsing XML document: cannot find device by uuid: " << *deviceName
-                       << ", skipping device";
-          return true;
+          *text = trim((const char *)xmlTextReaderConstValue(reader));
+          found = true;
         }
       }
-      else
+      else if (type == XML_READER_TYPE_ELEMENT)
       {
-        auto uuid = attributeValue(dev, "uuid");
-        device = contract->findDevice(uuid);
-        if (!device)
-        {
-          LOG(warning) << "Parsing XML document: cannot find device by uuid: " << uuid
-                       << ", skipping device";
+        if (!child(reader))
+          readContent(reader, nullptr);
+      }
+    }
+  }
+
+  inline static void dataSet(xmlTextReaderPtr reader, bool table, DataSet &ds, string &text)
+  {
+    readContent(reader, &text, [table, &ds](xmlTextReaderPtr reader) {
+      if (!nameIs(reader, "Entry"))
+        return false;
+
+      DataSetEntry entry;
+      entry.m_key = attributeValue(reader, "key");
+      entry.m_removed = attributeValue(reader, "removed") == "true";
+
+      if (table)
+      {
+        entry.m_value.emplace<DataSet>();
+        DataSet &row = get<DataSet>(entry.m_value);
+
+        readContent(reader, nullptr, [&row](xmlTextReaderPtr reader) {
+          if (!nameIs(reader, "Cell"))
+            return false;
+
+          auto key = attributeValue(reader, "key");
+          string value;
+          readContent(reader, &value);
+          row.emplace(key, type(value));
           return true;
-        }
+        });
+
+        if (row.empty())
+          entry.m_value.emplace<monostate>();
       }
+      else
+      {
+        string value;
+        readContent(reader, &value);
+        entry.m_value = type(value);
+      }
+
+      ds.insert(entry);
+      return true;
+    });
+  }
+
+  inline static void parseObservation(ResponseDocument &out, xmlTextReaderPtr reader,
+                                      const DevicePtr &device)
+  {
+    Properties properties;
+    eachAttribute(reader, [&properties](const char *name, const char *value) {
+      if (strcmp("sequence", name) != 0)
+        properties.insert({name, string(value)});
+    });
+
+    string name((const char *)xmlTextReaderConstLocalName(reader));
+    auto di = findDataItem(name, device, properties);
+    if (!di)
+    {
+      readContent(reader, nullptr);
+      return;
+    }
+
+    string val;
+    DataSet ds;
+    if (di->isDataSet())
+      dataSet(reader, di->isTable(), ds, val);
+    else
+      readContent(reader, &val);
+
+    if (di->isDataSet() && val != "UNAVAILABLE")
+      properties.insert({"VALUE", std::move(ds)});
+    else
+      properties.insert({"VALUE", val});
 
-      eachElement(dev, "ComponentStream", [&out, &device](xmlNodePtr comp) {
-        eachElement(comp, [&out, &device](xmlNodePtr org) {
-          eachElement(org, [&out, &device](xmlNodePtr o) {
-            Properties properties;
+    addObservation(out, device, di, properties);
+  }
+
+  inline static bool parseHeader(ResponseDocument &out, xmlTextReaderPtr reader)
+  {
+    string instanceId, next, last;
+    eachAttribute(reader, [&instanceId, &next, &last](const char *name, const char *value) {
+      if (strcmp("instanceId", name) == 0)
+        instanceId = value;
+      else if (strcmp("nextSequence", name) == 0)
+        next = value;
+      else if (strcmp("lastSequence", name) == 0)
+        last = value;
+    });
 
-            eachAttribute(o, [&properties](xmlAttrPtr attr) {
-              if (xmlStrcmp(BAD_CAST "sequence", attr->name) != 0)
+    if (instanceId.empty())
+      return false;
+
+    out.m_instanceId = boost::lexical_cast<uint64_t>(instanceId);
+    if (!next.empty())
+      out.m_next = boost::lexical_cast<SequenceNumber_t>(next);
+    if (!last.empty())
+      out.m_last = boost::lexical_cast<SequenceNumber_t>(last);
+    return true;
+  }
+
+  // The reader is positioned on the MTConnectStreams element. Observations are at the fifth
+  // level: Streams/DeviceStream/ComponentStream/<Category>/<Observation>.
+  inline static bool parseStreams(ResponseDocument &out, xmlTextReaderPtr reader,
+                                  pipeline::PipelineContextPtr context,
+                                  const std::optional<std::string> &deviceName)
+  {
+    auto contract = context->m_contract.get();
+    bool header = false, streams = false;
+    DevicePtr device;
+
+    auto ret = xmlTextReaderRead(reader);
+    while (ret == 1)
+    {
+      bool skip = false;
+      if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT)
+      {
+        switch (xmlTextReaderDepth(reader))
+        {
+          case 1:
+            if (nameIs(reader, "Header"))
+            {
+              header = parseHeader(out, reader);
+              if (!header)
               {
-                string s((const char *)attr->children->content);
-                properties.insert({(const char *)attr->name, s});
+                LOG(error) << "Cannot find instanceId in header for streams doc";
+                return false;
               }
+              skip = true;
+            }
+            else if (nameIs(reader, "Streams"))
+            {
+              if (!header)
+              {
+                LOG(error) << "Cannot find next in header for streams doc";
+                return false;
+              }
+              streams = true;
+            }
+            else
+            {
+              skip = true;
+            }
+            break;
 
-              return true;
-            });
-
-            // Check for table or data set
-            string name((const char *)o->name);
-            auto di = findDataItem(name, device, properties);
-            if (!di)
+          case 2:
+            device.reset();
+            if (nameIs(reader, "DeviceStream"))
             {
-              return true;
+              auto uuid = deviceName ? *deviceName : attributeValue(reader, "uuid");
+              device = contract->findDevice(uuid);
+              if (!device)
+                LOG(warning) << "Parsing XML document: cannot find device by uuid: " << uuid
+                             << ", skipping device";
             }
+            skip = !device;
+            break;
+
+          case 3:
+            skip = !nameIs(reader, "ComponentStream");
+            break;
+
+          case 4:
+            // Samples, Events, and Condition
+            break;
 
-            // Remove old properties
-            properties.erase("name");
-            properties.erase("dataItemId");
+          default:
+            parseObservation(out, reader, device);
+            break;
+        }
+      }
+
+      ret = skip ? xmlTextReaderNext(reader) : xmlTextReaderRead(reader);
+    }
 
-            auto ts = properties["timestamp"];
-            auto timestamp = parseTimestamp(get<string>(ts));
+    if (ret < 0)
+    {
+      LOG(error) << "Could not parse streams document";
+      out.m_entities.clear();
+      out.m_assetEvents.clear();
+      return false;
+    }
+
+    if (!header)
+      LOG(error) << "Cannot find next in header for streams doc";
+
+    return header && streams;
+  }
+
+  // Decodes the documents of the JsonPrinter and the CborPrinter with the nlohmann SAX interface
+  // so no json values are built. Both json versions are handled by deriving the context of each
+  // container from its parent and key, members of arrays take the context of the array.
+  class JsonResponseDecoder : public nlohmann::json_sax<nlohmann::json>
+  {
+  public:
+    JsonResponseDecoder(ResponseDocument &out, pipeline::PipelineContextPtr context,
+                        const std::optional<std::string> &device)
+      : m_out(out), m_contract(context->m_contract.get()), m_deviceName(device)
+    {}
 
-            auto val = text(o);
-            if (val == "UNAVAILABLE" || (!di->isDataSet() && !di->isAssetRemoved()))
+    bool result() const { return m_type == STREAMS_DOC && m_header && m_streams; }
+
+    bool null() override
+    {
+      if (!m_stack.empty() && m_stack.back().m_context == DOCUMENT && m_key == "Streams")
+        m_streams = true;
+      return true;
+    }
+    bool boolean(bool val) override { return scalar(val); }
+    bool number_integer(number_integer_t val) override { return scalar(int64_t(val)); }
+    bool number_unsigned(number_unsigned_t val) override { return scalar(int64_t(val)); }
+    bool number_float(number_float_t val, const string_t &) override { return scalar(double(val)); }
+    bool string(string_t &val) override { return scalar(std::move(val)); }
+    bool binary(binary_t &) override { return true; }
+    bool key(string_t &val) override
+    {
+      m_key = val;
+      return true;
+    }
+    bool start_object(std::size_t) override { return start(false); }
+    bool start_array(std::size_t) override { return start(true); }
+    bool end_object() override { return end(); }
+    bool end_array() override { return end(); }
+    bool parse_error(std::size_t position, const std::string &,
+                     const nlohmann::detail::exception &ex) override
+    {
+      LOG(error) << "Could not parse response document at " << position << ": " << ex.what();
+      return false;
+    }
+
+  protected:
+    enum Context
+    {
+      ROOT,
+      DOCUMENT,
+      HEADER,
+      STREAMS,
+      DEVICE,
+      COMPONENTS,
+      COMPONENT,
+      CATEGORY,
+      OBSERVATION,
+      VECTOR,
+      DATA_SET,
+      ROW,
+      ERROR_LIST,
+      ERROR_ENTRY,
+      SKIP
+    };
+
+    enum Type
+    {
+      UNKNOWN,
+      STREAMS_DOC,
+      ERROR_DOC
+    };
+
+    struct Frame
+    {
+      std::string m_key;
+      Context m_context;
+      bool m_array;
+    };
+
+    Context context(Context parent, const std::string &key, bool array)
+    {
+      switch (parent)
+      {
+        case ROOT:
+          if (key == "MTConnectStreams")
+            m_type = STREAMS_DOC;
+          else if (key == "MTConnectError")
+            m_type = ERROR_DOC;
+          else
+            LOG(error) << "Unsupported document type: " << key;
+          return m_type == UNKNOWN ? SKIP : DOCUMENT;
+
+        case DOCUMENT:
+          if (key == "Header")
+            return HEADER;
+          else if (key == "Streams")
+          {
+            m_streams = true;
+            return STREAMS;
+          }
+          else if (key == "Errors")
+            return ERROR_LIST;
+          else if (key == "Error")
+            return ERROR_ENTRY;
+          break;
+
+        case STREAMS:
+          if (key == "DeviceStream")
+            return DEVICE;
+          break;
+
+        case DEVICE:
+          if (key == "ComponentStreams")
+            return COMPONENTS;
+          else if (key == "ComponentStream")
+            return COMPONENT;
+          break;
+
+        case COMPONENTS:
+          if (key == "ComponentStream")
+            return COMPONENT;
+          break;
+
+        case COMPONENT:
+          if (key == "Samples" || key == "Events" || key == "Condition")
+            return CATEGORY;
+          break;
+
+        case CATEGORY:
+          return OBSERVATION;
+
+        case OBSERVATION:
+          if (key == "value")
+            return array ? VECTOR : DATA_SET;
+          break;
+
+        case DATA_SET:
+          if (!array)
+            return ROW;
+          break;
+
+        case ERROR_LIST:
+          if (key == "Error")
+            return ERROR_ENTRY;
+          break;
+
+        default:
+          break;
+      }
+
+      return SKIP;
+    }
+
+    bool start(bool array)
+    {
+      Frame frame {m_key, ROOT, array};
+      if (!m_stack.empty())
+      {
+        auto &parent = m_stack.back();
+        if (parent.m_array && parent.m_context != VECTOR)
+        {
+          frame.m_key = parent.m_key;
+          frame.m_context = parent.m_context;
+        }
+        else
+        {
+          frame.m_context = context(parent.m_context, m_key, array);
+        }
+      }
+
+      if (!array)
+      {
+        switch (frame.m_context)
+        {
+          case DEVICE:
+            m_uuid.clear();
+            m_pending.clear();
+            m_device.reset();
+            if (m_deviceName)
             {
-              properties.insert({"VALUE", val});
+              m_device = m_contract->findDevice(*m_deviceName);
+              if (!m_device)
+                LOG(warning) << "Parsing document: cannot find device by uuid: " << *m_deviceName
+                             << ", skipping device";
             }
-            else if (di->isAssetRemoved())
+            break;
+
+          case OBSERVATION:
+            m_properties.clear();
+            break;
+
+          case DATA_SET:
+            m_dataSet.clear();
+            break;
+
+          case ROW:
+            m_row.clear();
+            m_removed = false;
+            break;
+
+          case ERROR_ENTRY:
+            m_error = ResponseDocument::Error();
+            break;
+
+          default:
+            break;
+        }
+      }
+      else if (frame.m_context == VECTOR)
+      {
+        m_vector.clear();
+      }
+
+      m_stack.emplace_back(std::move(frame));
+      return true;
+    }
+
+    bool end()
+    {
+      if (m_stack.empty())
+        return false;
+
+      auto frame = std::move(m_stack.back());
+      m_stack.pop_back();
+
+      if (frame.m_array)
+      {
+        if (frame.m_context == VECTOR)
+          m_properties.insert_or_assign("VALUE", std::move(m_vector));
+        return true;
+      }
+
+      switch (frame.m_context)
+      {
+        case DEVICE:
+          if (!m_deviceName && !m_pending.empty())
+          {
+            m_device = m_contract->findDevice(m_uuid);
+            if (m_device)
             {
-              auto ac = make_shared<pipeline::AssetCommand>(
-                  "AssetCommand", Properties {{"assetId"s, val},
-                                              {"device"s, *(device->getUuid())},
-                                              {"VALUE"s, "RemoveAsset"s}});
-              out.m_entities.emplace_back(ac);
-              return true;
+              for (auto &p : m_pending)
+                observation(p.first, p.second);
             }
-            else  // isDataSet
+            else
             {
-              Value &v = properties["VALUE"];
-              v.emplace<DataSet>();
-              DataSet &ds = get<DataSet>(v);
-              dataSet(o, di->isTable(), ds);
+              LOG(warning) << "Parsing document: cannot find device by uuid: " << m_uuid
+                           << ", skipping device";
             }
+          }
+          m_pending.clear();
+          m_device.reset();
+          break;
+
+        case OBSERVATION:
+          if (m_device)
+            observation(frame.m_key, m_properties);
+          else if (!m_deviceName)
+            m_pending.emplace_back(frame.m_key, std::move(m_properties));
+          break;
 
-            ErrorList errors;
-            auto obs = observation::Observation::make(di, properties, timestamp, errors);
-            if (!errors.empty())
+        case DATA_SET:
+          m_properties.insert_or_assign("VALUE", std::move(m_dataSet));
+          break;
+
+        case ROW:
+          if (m_row.empty())
+            m_dataSet.emplace(frame.m_key, DataSetValue(), m_removed);
+          else
+            m_dataSet.emplace(frame.m_key, DataSetValue(std::move(m_row)));
+          break;
+
+        case ERROR_ENTRY:
+          LOG(error) << "Received protocol error: " << m_error.m_code << " " << m_error.m_message;
+          m_out.m_errors.emplace_back(std::move(m_error));
+          break;
+
+        default:
+          break;
+      }
+
+      return true;
+    }
+
+    template <typename T>
+    bool scalar(T &&val)
+    {
+      if (m_stack.empty())
+        return true;
+
+      auto &frame = m_stack.back();
+      switch (frame.m_context)
+      {
+        case HEADER:
+          if constexpr (std::is_same_v<std::decay_t<T>, int64_t>)
+          {
+            if (m_key == "instanceId")
             {
-              for (auto &e : errors)
-              {
-                LOG(warning) << "Error while parsing XML: " << e->what();
-              }
-              return true;
+              m_out.m_instanceId = uint64_t(val);
+              m_header = true;
+            }
+            else if (m_key == "nextSequence")
+            {
+              m_out.m_next = SequenceNumber_t(val);
+            }
+            else if (m_key == "lastSequence")
+            {
+              m_out.m_last = SequenceNumber_t(val);
             }
+          }
+          break;
+
+        case DEVICE:
+          if constexpr (std::is_same_v<std::decay_t<T>, std::string>)
+          {
+            if (m_key == "uuid")
+              m_uuid = val;
+          }
+          break;
 
-            if (di->isAssetChanged())
-              out.m_assetEvents.emplace_back((obs));
+        case OBSERVATION:
+          if (!frame.m_array && m_key != "sequence")
+          {
+            if (m_key == "value")
+              m_properties.insert_or_assign("VALUE", std::forward<T>(val));
             else
-              out.m_entities.emplace_back(obs);
-            return true;
-          });
-          return true;
-        });
+              m_properties.insert_or_assign(m_key, std::forward<T>(val));
+          }
+          break;
 
-        return true;
-      });
+        case VECTOR:
+          if constexpr (std::is_arithmetic_v<std::decay_t<T>> &&
+                        !std::is_same_v<std::decay_t<T>, bool>)
+            m_vector.push_back(double(val));
+          break;
+
+        case DATA_SET:
+          if constexpr (!std::is_same_v<std::decay_t<T>, bool>)
+            m_dataSet.emplace(m_key, DataSetValue(std::forward<T>(val)));
+          break;
+
+        case ROW:
+          if constexpr (std::is_same_v<std::decay_t<T>, bool>)
+          {
+            if (m_key == "removed")
+              m_removed = val;
+          }
+          else
+          {
+            m_row.emplace(m_key, DataSetValue(std::forward<T>(val)));
+          }
+          break;
+
+        case ERROR_ENTRY:
+          if constexpr (std::is_same_v<std::decay_t<T>, std::string>)
+          {
+            if (m_key == "errorCode")
+              m_error.m_code = val;
+            else if (m_key == "value")
+              m_error.m_message = trim(val);
+          }
+          break;
+
+        default:
+          break;
+      }
 
       return true;
-    });
+    }
 
-    return true;
+    void observation(const std::string &name, Properties &properties)
+    {
+      auto di = findDataItem(name, m_device, properties);
+      if (!di)
+        return;
+
+      if (properties.count("VALUE") == 0)
+        properties.insert({"VALUE", std::string()});
+
+      addObservation(m_out, m_device, di, properties);
+    }
+
+  protected:
+    ResponseDocument &m_out;
+    PipelineContract *m_contract;
+    const std::optional<std::string> &m_deviceName;
+
+    Type m_type {UNKNOWN};
+    bool m_header {false};
+    bool m_streams {false};
+
+    std::vector<Frame> m_stack;
+    std::string m_key;
+
+    DevicePtr m_device;
+    std::string m_uuid;
+    std::list<std::pair<std::string, Properties>> m_pending;
+
+    Properties m_properties;
+    entity::Vector m_vector;
+    DataSet m_dataSet;
+    DataSet m_row;
+    bool m_removed {false};
+    ResponseDocument::Error m_error;
+  };
+
+  inline static bool parseJson(const std::string_view &content, ResponseDocument &out,
+                               pipeline::PipelineContextPtr context,
+                               const std::optional<std::string> &device,
+                               nlohmann::json::input_format_t format)
+  {
+    JsonResponseDecoder decoder(out, context, device);
+    if (!nlohmann::json::sax_parse(content.begin(), content.end(), &decoder, format))
+    {
+      out.m_entities.clear();
+      out.m_assetEvents.clear();
+      return false;
+    }
+
+    return decoder.result();
   }
 
   inline static bool parseAssets(ResponseDocument &out, xmlNodePtr node,
@@ -436,8 +1009,40 @@ namespace mtconnect::pipeline {
                                pipeline::PipelineContextPtr context,
                                const std::optional<std::string> &device)
   {
+    // The JsonPrinter and CborPrinter documents are objects, anything else is XML
+    auto first = content.find_first_not_of(" \t\r\n");
+    if (first == string_view::npos)
+      return false;
+    auto lead = static_cast<uint8_t>(content[first]);
+    if (lead == '{')
+      return parseJson(content.substr(first), out, context, device,
+                       nlohmann::json::input_format_t::json);
+    else if ((lead & 0xE0) == 0xA0)  // CBOR map
+      return parseJson(content.substr(first), out, context, device,
+                       nlohmann::json::input_format_t::cbor);
+
     // xmlInitParser();
     // xmlXPathInit();
+    {
+      unique_ptr<xmlTextReader, function<void(xmlTextReaderPtr)>> reader(
+          xmlReaderForMemory(content.data(), static_cast<int>(content.length()), "incoming.xml",
+                             nullptr, XML_PARSE_NOBLANKS),
+          [](xmlTextReaderPtr r) { xmlFreeTextReader(r); });
+      if (!reader)
+        return false;
+
+      int ret;
+      while ((ret = xmlTextReaderRead(reader.get())) == 1 &&
+             xmlTextReaderNodeType(reader.get()) != XML_READER_TYPE_ELEMENT)
+        ;
+      if (ret != 1)
+        return false;
+
+      if (nameIs(reader.get(), "MTConnectStreams"))
+        return parseStreams(out, reader.get(), context, device);
+    }
+
+    // Assets and errors are small, use the DOM
     unique_ptr<xmlDoc, function<void(xmlDocPtr)>> doc(
         xmlReadMemory(content.data(), static_cast<int>(content.length()), "incoming.xml", nullptr,
                       XML_PARSE_NOBLANKS),
@@ -450,11 +1055,7 @@ namespace mtconnect::pipeline {
         LOG(error) << "Cannot find next in header for streams doc";
         return false;
       }
-      if (xmlStrcmp(BAD_CAST "MTConnectStreams", root->name) == 0)
-      {
-        return parseObservations(out, root, context, device);
-      }
-      else if (xmlStrcmp(BAD_CAST "MTConnectAssets", root->name) == 0)
+      if (xmlStrcmp(BAD_CAST "MTConnectAssets", root->name) == 0)
       {
         return parseAssets(out, root, device);
       }
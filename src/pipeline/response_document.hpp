@@ -40,6 +40,7 @@ namespace mtconnect::pipeline {
 
     // Parsed data
     SequenceNumber_t m_next;
+    SequenceNumber_t m_last = 0;
     uint64_t m_instanceId;
     entity::EntityList m_entities;
     entity::EntityList m_assetEvents;
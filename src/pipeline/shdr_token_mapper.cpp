@@ -30,7 +30,7 @@ using namespace std;
 namespace mtconnect {
   using namespace observation;
   namespace pipeline {
-    inline bool unavailable(const string &str)
+    inline bool unavailable(const string_view &str)
     {
       const static string unavailable("UNAVAILABLE");
       return equal(str.cbegin(), str.cend(), unavailable.cbegin(), unavailable.cend(),
@@ -38,13 +38,13 @@ namespace mtconnect {
     }
 
     inline static std::pair<std::string, std::optional<std::string>> splitKey(
-        const std::string &key)
+        const std::string_view &key)
     {
       auto c = key.find(':');
       if (c != string::npos)
-        return {key.substr(c + 1, string::npos), key.substr(0, c)};
+        return {string(key.substr(c + 1, string::npos)), string(key.substr(0, c))};
       else
-        return {key, nullopt};
+        return {string(key), nullopt};
     }
 
     inline optional<double> getDuration(std::string &timestamp)
@@ -87,7 +87,7 @@ namespace mtconnect {
     static entity::Requirements s_event {{"VALUE", false}};
     static entity::Requirements s_dataSet {{"VALUE", entity::DATA_SET, false}};
 
-    static inline size_t firtNonWsColon(const string &token)
+    static inline size_t firtNonWsColon(const string_view &token)
     {
       auto len = token.size();
       for (size_t i = 0; i < len; i++)
@@ -101,7 +101,8 @@ namespace mtconnect {
       return string::npos;
     }
 
-    static inline std::string extractResetTrigger(const DataItemPtr dataItem, const string &token,
+    static inline std::string extractResetTrigger(const DataItemPtr dataItem,
+                                                  const string_view &token,
                                                   Properties &properties)
     {
       size_t pos;
@@ -109,7 +110,7 @@ namespace mtconnect {
       auto hasResetTriggered = dataItem->hasProperty("ResetTrigger");
       if (hasResetTriggered || dataItem->isTable() || dataItem->isDataSet())
       {
-        string trig, value;
+        string_view trig, value;
         if (!dataItem->isDataSet() && (pos = token.find(':')) != string::npos)
         {
           trig = token.substr(pos + 1);
@@ -124,21 +125,27 @@ namespace mtconnect {
         }
         else
         {
-          return token;
+          return string(token);
         }
 
         if (!trig.empty())
-          properties.insert_or_assign("resetTriggered", upcase(trig));
-        return value;
+        {
+          string t(trig);
+          properties.insert_or_assign("resetTriggered", upcase(t));
+        }
+        return string(value);
       }
       else
       {
-        return token;
+        return string(token);
       }
     }
 
+    // Without a reset trigger to extract, numbers are parsed straight from the token view and
+    // strings are copied once. Tokens the fast path cannot parse take the generic conversion
+    // so errors and lenient parsing behave as before.
     inline ObservationPtr zipProperties(const DataItemPtr dataItem, const Timestamp &timestamp,
-                                        const entity::Requirements &reqs,
+                                        const entity::Requirements &reqs, bool resetTrigger,
                                         TokenList::const_iterator &token,
                                         const TokenList::const_iterator &end, ErrorList &errors)
     {
@@ -146,7 +153,7 @@ namespace mtconnect {
       Properties props;
       for (auto req = reqs.begin(); token != end && req != reqs.end(); token++, req++)
       {
-        const string &tok = *token;
+        const string_view &tok = *token;
 
         if (req->getName() == "VALUE" || req->getName() == "level")
         {
@@ -160,7 +167,43 @@ namespace mtconnect {
           continue;
         }
 
-        entity::Value value {extractResetTrigger(dataItem, tok, props)};
+        if (!resetTrigger)
+        {
+          auto type = req->getType();
+          if (type == entity::DOUBLE)
+          {
+            if (auto d = parseDouble(tok))
+            {
+              props.insert_or_assign(req->getName(), *d);
+              continue;
+            }
+          }
+          else if (type == entity::INTEGER)
+          {
+            if (auto i = parseInteger(tok))
+            {
+              props.insert_or_assign(req->getName(), *i);
+              continue;
+            }
+          }
+          else if (type == entity::STRING)
+          {
+            props.insert_or_assign(req->getName(), string(tok));
+            continue;
+          }
+          else if (type == entity::VECTOR)
+          {
+            entity::Vector values;
+            if (parseVector(tok, values))
+            {
+              props.insert_or_assign(req->getName(), std::move(values));
+              continue;
+            }
+          }
+        }
+
+        entity::Value value {resetTrigger ? extractResetTrigger(dataItem, tok, props)
+                                          : string(tok)};
 
         try
         {
@@ -177,6 +220,78 @@ namespace mtconnect {
       return Observation::make(dataItem, props, timestamp, errors);
     }
 
+    static inline const entity::Requirements *requirementsFor(const DataItemPtr &dataItem)
+    {
+      if (dataItem->isSample())
+      {
+        if (dataItem->isTimeSeries())
+          return &s_timeseries;
+        else if (dataItem->isThreeSpace())
+          return &s_threeSpaceSample;
+        else
+          return &s_sample;
+      }
+      else if (dataItem->isEvent())
+      {
+        if (dataItem->isMessage())
+          return &s_message;
+        else if (dataItem->isAlarm())
+          return &s_alarm;
+        else if (dataItem->isDataSet() || dataItem->isTable())
+          return &s_dataSet;
+        else if (dataItem->isAssetChanged() || dataItem->isAssetRemoved())
+          return &s_assetEvent;
+        else
+          return &s_event;
+      }
+      else if (dataItem->isCondition())
+      {
+        return &s_condition;
+      }
+
+      return nullptr;
+    }
+
+    const ShdrTokenMapper::MappedDataItem &ShdrTokenMapper::findDataItem(
+        const std::string_view &key)
+    {
+      auto generation = m_contract->deviceGeneration();
+      if (generation != m_generation)
+      {
+        m_dataItems.clear();
+        m_keys.clear();
+        m_generation = generation;
+      }
+
+      if (m_generation)
+      {
+        auto it = m_dataItems.find(key);
+        if (it != m_dataItems.end())
+          return it->second;
+      }
+
+      auto dataItemKey = splitKey(key);
+      string device = dataItemKey.second.value_or(m_defaultDevice.value_or(""));
+      MappedDataItem mapped;
+      mapped.m_dataItem = m_contract->findDataItem(device, dataItemKey.first);
+      if (mapped.m_dataItem)
+      {
+        auto &di = mapped.m_dataItem;
+        mapped.m_requirements = requirementsFor(di);
+        mapped.m_resetTrigger = di->hasProperty("ResetTrigger") || di->isTable() || di->isDataSet();
+      }
+
+      // Misses are not cached, so unknown keys from an adapter cannot grow the table
+      if (!m_generation || !mapped.m_dataItem)
+      {
+        m_uncached = mapped;
+        return m_uncached;
+      }
+
+      auto &owned = m_keys.emplace_back(key);
+      return m_dataItems.emplace(owned, mapped).first->second;
+    }
+
     EntityPtr ShdrTokenMapper::mapTokensToDataItem(const Timestamp &timestamp,
                                                    const std::optional<std::string> &source,
                                                    TokenList::const_iterator &token,
@@ -184,19 +299,20 @@ namespace mtconnect {
                                                    ErrorList &errors)
     {
       NAMED_SCOPE("DataItemMapper.ShdrTokenMapper.mapTokensToDataItem");
-      auto dataItemKey = splitKey(*token++);
-      string device = dataItemKey.second.value_or(m_defaultDevice.value_or(""));
-      auto dataItem = m_contract->findDataItem(device, dataItemKey.first);
+      auto key = *token++;
+      auto &mapped = findDataItem(key);
+      auto &dataItem = mapped.m_dataItem;
 
       if (dataItem == nullptr)
       {
         // resync to next item
-        if (m_logOnce.count(dataItemKey.first) > 0)
-          LOG(trace) << "Could not find data item: " << dataItemKey.first;
+        auto name = splitKey(key).first;
+        if (m_logOnce.count(name) > 0)
+          LOG(trace) << "Could not find data item: " << name;
         else
         {
-          LOG(info) << "Could not find data item: " << dataItemKey.first;
-          m_logOnce.insert(dataItemKey.first);
+          LOG(info) << "Could not find data item: " << name;
+          m_logOnce.insert(name);
         }
 
         // Skip following tolken if we are in legacy mode
@@ -206,39 +322,11 @@ namespace mtconnect {
         return nullptr;
       }
 
-      entity::Requirements *reqs {nullptr};
-
       // Extract the remaining tokens
-      if (dataItem->isSample())
+      if (mapped.m_requirements != nullptr)
       {
-        if (dataItem->isTimeSeries())
-          reqs = &s_timeseries;
-        else if (dataItem->isThreeSpace())
-          reqs = &s_threeSpaceSample;
-        else
-          reqs = &s_sample;
-      }
-      else if (dataItem->isEvent())
-      {
-        if (dataItem->isMessage())
-          reqs = &s_message;
-        else if (dataItem->isAlarm())
-          reqs = &s_alarm;
-        else if (dataItem->isDataSet() || dataItem->isTable())
-          reqs = &s_dataSet;
-        else if (dataItem->isAssetChanged() || dataItem->isAssetRemoved())
-          reqs = &s_assetEvent;
-        else
-          reqs = &s_event;
-      }
-      else if (dataItem->isCondition())
-      {
-        reqs = &s_condition;
-      }
-
-      if (reqs != nullptr)
-      {
-        auto obs = zipProperties(dataItem, timestamp, *reqs, token, end, errors);
+        auto obs = zipProperties(dataItem, timestamp, *mapped.m_requirements,
+                                 mapped.m_resetTrigger, token, end, errors);
         if (dataItem->getConstantValue())
           return nullptr;
         if (obs && source)
@@ -247,7 +335,7 @@ namespace mtconnect {
       }
       else
       {
-        LOG(warning) << "Cannot find requirements for " << dataItemKey.first;
+        LOG(warning) << "Cannot find requirements for " << splitKey(key).first;
         throw entity::PropertyError("Unresolved data item requirements");
       }
 
@@ -265,9 +353,9 @@ namespace mtconnect {
       auto command = *token++;
       if (command == "@ASSET@")
       {
-        auto assetId = *token++;
+        string assetId(*token++);
         auto type = *token++;
-        auto body = *token++;
+        string body(*token++);
 
         XmlParser parser;
         res = parser.parse(Asset::getRoot(), body, "2.0", errors);
@@ -305,7 +393,7 @@ namespace mtconnect {
           if (token != end)
           {
             if (!token->empty())
-              ac->setProperty("type", *token);
+              ac->setProperty("type", string(*token));
             token++;
           }
           if (m_defaultDevice)
@@ -314,13 +402,13 @@ namespace mtconnect {
         else if (command == "@REMOVE_ASSET@")
         {
           ac->setValue("RemoveAsset"s);
-          ac->setProperty("assetId", *token++);
+          ac->setProperty("assetId", string(*token++));
           if (m_defaultDevice)
             ac->setProperty("device", *m_defaultDevice);
         }
         else
         {
-          throw EntityError("Unkown asset command " + command);
+          throw EntityError("Unkown asset command " + string(command));
         }
         res = ac;
       }
@@ -334,7 +422,7 @@ namespace mtconnect {
       {
         // Don't copy the tokens.
         auto res = std::make_shared<Observations>(*timestamped, TokenList {});
-        EntityList entities;
+        EntityList mapped, entities;
 
         auto &tokens = timestamped->m_tokens;
         auto token = tokens.cbegin();
@@ -349,7 +437,7 @@ namespace mtconnect {
           {
             auto source = entity->maybeGet<string>("source");
             entity::ErrorList errors;
-            if ((*token)[0] == '@')
+            if (!token->empty() && token->front() == '@')
             {
               out = mapTokensToAsset(timestamped->m_timestamp, source, token, end, errors);
             }
@@ -361,11 +449,7 @@ namespace mtconnect {
             }
 
             if (out && errors.empty())
-            {
-              auto fwd = next(out);
-              if (fwd)
-                entities.emplace_back(fwd);
-            }
+              mapped.emplace_back(out);
 
             // For legacy token handling, stop if we have
             // consumed more than two tokens.
@@ -388,6 +472,16 @@ namespace mtconnect {
           }
         }
 
+        // Forward all the entities from the line as a single batch
+        try
+        {
+          next(mapped, entities);
+        }
+        catch (entity::EntityError &e)
+        {
+          LOG(error) << "Could not deliver observations: " << e.what();
+        }
+
         res->setValue(entities);
         return next(res);
       }
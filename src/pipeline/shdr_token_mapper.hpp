@@ -17,7 +17,10 @@
 #pragma once
 
 #include <chrono>
+#include <list>
 #include <regex>
+#include <string_view>
+#include <unordered_map>
 
 #include "entity/entity.hpp"
 #include "observation/observation.hpp"
@@ -33,7 +36,14 @@ namespace mtconnect {
     class ShdrTokenMapper : public Transform
     {
     public:
-      ShdrTokenMapper(const ShdrTokenMapper &) = default;
+      // The data item table holds views of its own keys, so it is not copied
+      ShdrTokenMapper(const ShdrTokenMapper &other)
+        : Transform(other),
+          m_logOnce(other.m_logOnce),
+          m_contract(other.m_contract),
+          m_defaultDevice(other.m_defaultDevice),
+          m_shdrVersion(other.m_shdrVersion)
+      {}
       ShdrTokenMapper(PipelineContextPtr context,
                       const std::optional<std::string> &device = std::nullopt, int version = 1)
         : Transform("ShdrTokenMapper"),
@@ -55,12 +65,31 @@ namespace mtconnect {
                                  TokenList::const_iterator &token,
                                  const TokenList::const_iterator &end, ErrorList &errors);
 
+    protected:
+      // A data item resolved from the raw SHDR key and the requirements for its tokens
+      struct MappedDataItem
+      {
+        DataItemPtr m_dataItem;
+        const entity::Requirements *m_requirements {nullptr};
+        bool m_resetTrigger {false};
+      };
+
+      // Resolve the SHDR key, device:name or name, using the table of previous lookups.
+      // The table is cleared when the contract's device generation changes.
+      const MappedDataItem &findDataItem(const std::string_view &key);
+
     protected:
       // Logging Context
       std::set<std::string> m_logOnce;
       PipelineContract *m_contract;
       std::optional<std::string> m_defaultDevice;
       int m_shdrVersion {1};
+
+      // Data item lookup table keyed by views of m_keys
+      std::unordered_map<std::string_view, MappedDataItem> m_dataItems;
+      std::list<std::string> m_keys;
+      std::optional<uint64_t> m_generation;
+      MappedDataItem m_uncached;
     };
   }  // namespace pipeline
 }  // namespace mtconnect
@@ -17,9 +17,14 @@
 
 #pragma once
 
+#include <boost/container/small_vector.hpp>
+
 #include <chrono>
+#include <list>
 #include <regex>
+#include <string_view>
 
+#include "char_scanner.hpp"
 #include "entity/entity.hpp"
 #include "transform.hpp"
 
@@ -27,16 +32,32 @@ namespace mtconnect {
   class Agent;
 
   namespace pipeline {
-    using TokenList = std::list<std::string>;
+    // Views of the fields of an SHDR line. The text is owned by the Tokens entity.
+    using TokenList = boost::container::small_vector<std::string_view, 32>;
     class Tokens : public entity::Entity
     {
     public:
       using entity::Entity::Entity;
       Tokens(const Tokens &) = default;
       Tokens() = default;
-      Tokens(const Tokens &ts, TokenList list) : Entity(ts), m_tokens(list) {}
+      Tokens(const Tokens &ts, TokenList list)
+        : Entity(ts), m_tokens(list), m_source(ts.m_source), m_owned(ts.m_owned)
+      {}
+
+      // Keep a string for the lifetime of the tokens and return a view of it. Used for
+      // fields that cannot refer to the source text, such as unescaped fields.
+      std::string_view own(std::string &&str)
+      {
+        if (!m_owned)
+          m_owned = std::make_shared<std::list<std::string>>();
+        return m_owned->emplace_back(std::move(str));
+      }
 
       TokenList m_tokens;
+
+      // The entity holding the text the tokens refer to.
+      entity::EntityPtr m_source;
+      std::shared_ptr<std::list<std::string>> m_owned;
     };
 
     class ShdrTokenizer : public Transform
@@ -53,7 +74,10 @@ namespace mtconnect {
         if (auto source = data->maybeGet<std::string>("source"))
           props["source"] = *source;
         auto result = std::make_shared<Tokens>("Tokens", props);
-        tokenize(body, result->m_tokens);
+
+        // The tokens are views into the data entity's body.
+        result->m_source = data;
+        tokenize(body, *result);
         return next(result);
       }
 
@@ -83,83 +107,109 @@ namespace mtconnect {
           return str.substr(first, last - first + 1);
       }
 
-      static inline void tokenize(const std::string &data, TokenList &tokens)
+      inline static std::string_view trimEnd(std::string_view str)
       {
-        using namespace std;
-        auto cp = data.c_str();
-        std::string token;
-        bool copied {false};
-        while (*cp != '\0')
+        while (!str.empty() && isspace(static_cast<unsigned char>(str.back())))
+          str.remove_suffix(1);
+        return str;
+      }
+
+      using FieldScanner = CharScanner<'|'>;
+      using QuotedFieldScanner = CharScanner<'|', '"', '\\'>;
+
+      // Split the line into fields separated by '|'. A field starting with a '"' is quoted
+      // and may contain escaped characters, including '|'. The fields are views into data,
+      // only fields with escapes are copied and owned by the tokens.
+      static inline void tokenize(std::string_view data, Tokens &tokens)
+      {
+        auto &list = tokens.m_tokens;
+        const auto len = data.size();
+        const auto base = data.data();
+        auto scan = [base, len](auto scanner, size_t from) -> size_t {
+          return decltype(scanner)::find(base + from, base + len) - base;
+        };
+        size_t cp = 0;
+        while (cp < len)
         {
-          while (*cp != '\0' && isspace(*cp))
+          while (cp < len && isspace(static_cast<unsigned char>(data[cp])))
             cp++;
 
-          auto start = cp, orig = cp;
-          const char *end = 0;
-          if (*cp == '"')
+          std::string_view token;
+          if (cp < len && data[cp] == '"')
           {
-            cp = ++start;
-            while (*cp != '\0')
+            const auto orig = cp;
+            std::string unescaped;
+            bool escaped {false}, terminated {false};
+            size_t segment = ++cp;
+            while ((cp = scan(QuotedFieldScanner(), cp)) < len)
             {
-              if (*cp == '\\')
+              auto c = data[cp];
+              if (c == '\\')
               {
-                if (!copied)
-                {
-                  token = start;
-                  size_t dist = cp - start;
-                  start = token.c_str();
-                  cp = start + dist;
-                  copied = true;
-                }
-                memmove(const_cast<char *>(cp), cp + 1, strlen(cp));
+                // Remove the backslash and take the next character as is.
+                escaped = true;
+                unescaped.append(data.substr(segment, cp - segment));
+                segment = ++cp;
+                if (cp < len)
+                  cp++;
+                continue;
               }
-              else if (*cp == '|')
+              else if (c == '|')
               {
                 break;
               }
-              else if (*cp == '"')
+              else if (c == '"')
               {
                 // Make sure there is a | or the string ends after the
                 // terminal ". Skip spaces.
                 auto nc = cp + 1;
-                while (*nc != '\0' && isspace(*nc))
+                while (nc < len && isspace(static_cast<unsigned char>(data[nc])))
                   nc++;
-                if (*nc == '|' || *nc == '\0')
-                  end = cp;
-                else
-                  break;
+                if (nc == len || data[nc] == '|')
+                {
+                  if (escaped)
+                  {
+                    unescaped.append(data.substr(segment, cp - segment));
+                    token = tokens.own(std::string(trimEnd(unescaped)));
+                  }
+                  else
+                  {
+                    token = data.substr(segment, cp - segment);
+                  }
+                  terminated = true;
+                  cp = nc;
+                }
+                break;
               }
-
-              if (*cp != '\0')
-                cp++;
             }
-            // If there was no terminating '"'
-            if (end == 0 && copied)
+
+            if (!terminated)
             {
-              // Undo copy
-              cp = start = orig;
-              while (*cp != '|' && *cp != '\0')
-                cp++;
+              if (escaped)
+              {
+                // If there was no terminating '"', take the field as is
+                cp = scan(FieldScanner(), orig);
+                token = data.substr(orig, cp - orig);
+              }
+              else
+              {
+                token = data.substr(orig + 1, cp - orig - 1);
+              }
             }
           }
           else
           {
-            while (*cp != '|' && *cp != '\0')
-              cp++;
+            auto start = cp;
+            cp = scan(FieldScanner(), cp);
+            token = data.substr(start, cp - start);
           }
 
-          if (end == 0)
-            end = cp;
-
-          while (end > start && isspace(*(end - 1)))
-            end--;
-
-          tokens.emplace_back(start, end);
+          list.emplace_back(trimEnd(token));
 
           // Handle terminal '|'
-          if (*cp == '|' && *(cp + 1) == '\0')
-            tokens.emplace_back("");
-          if (*cp != '\0')
+          if (cp < len && data[cp] == '|' && cp + 1 == len)
+            list.emplace_back();
+          if (cp < len)
             cp++;
         }
       }
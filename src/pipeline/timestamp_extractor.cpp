@@ -70,51 +70,51 @@ namespace mtconnect {
       bool has_t {timestamp.find('T') != string::npos};
       if (has_t)
       {
-        istringstream in(timestamp);
-        in >> std::setw(6) >> parse("%FT%T", ts);
-        if (!in.good())
-        {
+        if (auto parsed = parseTimestamp(timestamp))
+          ts = *parsed;
+        else
           ts = now();
-        }
 
-        if (!m_relativeTime)
-        {
-          entity->m_timestamp = ts;
-          return;
-        }
+        entity->m_timestamp = adjustTimestamp(ts);
+        return;
       }
 
       // Handle double offset
       Timestamp n = now();
-      double offset;
-      if (!has_t)
+      double offset = stod(timestamp);
+
+      if (!m_base)
+      {
+        m_base = n;
+        m_offset = Microseconds(int64_t(offset * 1000.0));
+        entity->m_timestamp = n;
+      }
+      else
       {
-        offset = stod(timestamp);
+        entity->m_timestamp = *m_base + Microseconds(int64_t(offset * 1000.0)) - m_offset;
       }
+    }
 
+    Timestamp ExtractTimestamp::adjustTimestamp(const Timestamp &ts)
+    {
+      using namespace date;
+      using namespace chrono;
+
+      if (!m_relativeTime)
+        return ts;
+
+      Timestamp n = now();
       if (!m_base)
       {
         m_base = n;
-        if (has_t)
-        {
-          auto t1 = round<Microseconds, system_clock>(ts);
-          auto t2 = round<Microseconds, system_clock>(n);
-          m_offset = t2 - t1;
-        }
-        else
-          m_offset = Microseconds(int64_t(offset * 1000.0));
-        entity->m_timestamp = n;
+        auto t1 = round<Microseconds, system_clock>(ts);
+        auto t2 = round<Microseconds, system_clock>(n);
+        m_offset = t2 - t1;
+        return n;
       }
       else
       {
-        if (has_t)
-        {
-          entity->m_timestamp = ts + m_offset;
-        }
-        else
-        {
-          entity->m_timestamp = *m_base + Microseconds(int64_t(offset * 1000.0)) - m_offset;
-        }
+        return ts + m_offset;
       }
     }
   }  // namespace pipeline
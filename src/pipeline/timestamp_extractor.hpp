@@ -74,8 +74,8 @@ namespace mtconnect {
             tokens && tokens->m_tokens.size() > 0)
         {
           res = std::make_shared<Timestamped>(*tokens);
-          token = res->m_tokens.front();
-          res->m_tokens.pop_front();
+          token = std::string(res->m_tokens.front());
+          res->m_tokens.erase(res->m_tokens.begin());
         }
         else if (ptr->hasProperty("timestamp"))
         {
@@ -94,6 +94,8 @@ namespace mtconnect {
       }
 
       void extractTimestamp(const std::string &token, TimestampedPtr &ts);
+      // Applies relative time to a timestamp that has already been parsed
+      virtual Timestamp adjustTimestamp(const Timestamp &ts);
       inline Timestamp now() { return m_now ? m_now() : std::chrono::system_clock::now(); }
 
       Now m_now;
@@ -119,7 +121,7 @@ namespace mtconnect {
             tokens && tokens->m_tokens.size() > 0)
         {
           res = std::make_shared<Timestamped>(*tokens);
-          res->m_tokens.pop_front();
+          res->m_tokens.erase(res->m_tokens.begin());
         }
         else if (res->hasProperty("timestamp"))
         {
@@ -130,6 +132,8 @@ namespace mtconnect {
 
         return next(res);
       }
+
+      Timestamp adjustTimestamp(const Timestamp &ts) override { return now(); }
     };
   }  // namespace pipeline
 }  // namespace mtconnect
@@ -22,6 +22,7 @@
 
 #include "entity/entity.hpp"
 #include "guard.hpp"
+#include "logging.hpp"
 #include "pipeline_context.hpp"
 
 namespace mtconnect {
@@ -110,6 +111,84 @@ namespace mtconnect {
         return EntityPtr();
       }
 
+      // Batch execution. Runs each entity through this transform and appends the
+      // non-null results. Transforms with shared state override this to amortize
+      // locking across the batch. An entity that fails is dropped on its own, the rest
+      // of the batch continues.
+      virtual void run(const entity::EntityList &entities, entity::EntityList &results)
+      {
+        for (const auto &entity : entities)
+        {
+          try
+          {
+            auto res = (*this)(entity);
+            if (res)
+              results.emplace_back(res);
+          }
+          catch (entity::EntityError &e)
+          {
+            LOG(error) << m_name << ": dropping " << entity->getName() << ": " << e.what();
+          }
+        }
+      }
+
+      // Forward a batch to the next transforms. Consecutive entities taking the same
+      // route are forwarded together so the order of the batch is preserved.
+      void next(const entity::EntityList &entities, entity::EntityList &results)
+      {
+        using namespace std;
+        using namespace entity;
+
+        if (m_next.empty())
+        {
+          results.insert(results.end(), entities.begin(), entities.end());
+          return;
+        }
+
+        EntityList group;
+        Transform *target {nullptr};
+        GuardAction action {CONTINUE};
+        auto forward = [&]() {
+          if (group.empty())
+            return;
+          if (action == RUN)
+            target->run(group, results);
+          else
+            target->next(group, results);
+          group.clear();
+        };
+
+        for (const auto &entity : entities)
+        {
+          Transform *to {nullptr};
+          GuardAction act {CONTINUE};
+          for (auto &t : m_next)
+          {
+            act = t->check(entity);
+            if (act != CONTINUE)
+            {
+              to = t.get();
+              break;
+            }
+          }
+
+          if (to == nullptr)
+          {
+            LOG(error) << "Cannot find matching transform for " << entity->getName();
+            continue;
+          }
+
+          if (to != target || act != action)
+          {
+            forward();
+            target = to;
+            action = act;
+          }
+          group.emplace_back(entity);
+        }
+        forward();
+      }
+
       TransformPtr bind(TransformPtr trans)
       {
         m_next.emplace_back(trans);
@@ -0,0 +1,50 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include "json_printer.hpp"
+
+namespace mtconnect::printer {
+  // Compact binary encoding of the JSON document model using CBOR (RFC 8949). The
+  // document structure is identical to the JsonPrinter, only the wire format differs,
+  // so clients avoid the cost of parsing text numbers and strings.
+  class CborPrinter : public JsonPrinter
+  {
+  public:
+    using JsonPrinter::JsonPrinter;
+    ~CborPrinter() override = default;
+
+    std::string mimeType() const override { return "application/mtconnect+cbor"; }
+
+    // Decode a document produced by this printer back into the JSON document model
+    static nlohmann::json decode(const std::string &buffer)
+    {
+      return nlohmann::json::from_cbor(buffer.begin(), buffer.end());
+    }
+
+  protected:
+    std::string render(const nlohmann::json &doc) const override
+    {
+      std::string buffer;
+      nlohmann::json::to_cbor(doc, buffer);
+      return buffer;
+    }
+  };
+}  // namespace mtconnect::printer
@@ -66,7 +66,7 @@ namespace mtconnect::printer {
     return m_hostname;
   }
 
-  inline std::string print(json &doc, bool pretty)
+  inline std::string print(const json &doc, bool pretty)
   {
     stringstream buffer;
     if (pretty)
@@ -77,6 +77,8 @@ namespace mtconnect::printer {
     return buffer.str();
   }
 
+  std::string JsonPrinter::render(const json &doc) const { return print(doc, m_pretty); }
+
   inline json header(const string &version, const string &hostname, const uint64_t instanceId,
                      const unsigned int bufferSize, const string &schemaVersion,
                      const string modelChangeTime)
@@ -142,7 +144,7 @@ namespace mtconnect::printer {
                                                  *m_schemaVersion, m_modelChangeTime)},
                                {"Errors", errors}}}});
 
-    return print(doc, m_pretty);
+    return render(doc);
   }
 
   template <class T>
@@ -197,7 +199,7 @@ namespace mtconnect::printer {
                                                            *m_schemaVersion, m_modelChangeTime)},
                                {"Devices", devicesDoc}}}});
 
-    return print(doc, m_pretty);
+    return render(doc);
   }
 
   class CategoryRef
@@ -433,7 +435,7 @@ namespace mtconnect::printer {
                                    lastSeq, *m_schemaVersion, m_modelChangeTime)},
            {"Streams", streams}}}});
 
-    return print(doc, m_pretty);
+    return render(doc);
   }
 
   std::string JsonPrinter::printAssets(const uint64_t instanceId, const unsigned int bufferSize,
@@ -470,6 +472,6 @@ namespace mtconnect::printer {
                                        *m_schemaVersion, m_modelChangeTime)},
            {"Assets", assetDoc}}}});
 
-    return print(doc, m_pretty);
+    return render(doc);
   }
 }  // namespace mtconnect::printer
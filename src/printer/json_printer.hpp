@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <nlohmann/json.hpp>
+
 #include "asset/cutting_tool.hpp"
 #include "printer/printer.hpp"
 #include "utilities.hpp"
@@ -47,6 +49,8 @@ namespace mtconnect::printer {
     uint32_t getJsonVersion() const { return m_jsonVersion; }
 
   protected:
+    // Serialize the document, subclasses can provide alternate encodings
+    virtual std::string render(const nlohmann::json &doc) const;
     const std::string &hostname() const;
     std::string m_version;
     std::string m_hostname;
@@ -568,7 +568,7 @@ namespace mtconnect::ruby {
             mrb_value ary = mrb_ary_new(mrb);
             for (auto &token : tokens->m_tokens)
             {
-              mrb_ary_push(mrb, ary, mrb_str_new_cstr(mrb, token.c_str()));
+              mrb_ary_push(mrb, ary, mrb_str_new(mrb, token.data(), token.size()));
             }
             return ary;
           },
@@ -587,7 +587,7 @@ namespace mtconnect::ruby {
               for (int i = 0; i < ARY_LEN(aryp); i++)
               {
                 auto item = ARY_PTR(aryp)[i];
-                tokens->m_tokens.push_back(stringFromRuby(mrb, item));
+                tokens->m_tokens.push_back(tokens->own(stringFromRuby(mrb, item)));
               }
             }
             return ary;
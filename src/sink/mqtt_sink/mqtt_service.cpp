@@ -59,7 +59,13 @@ namespace mtconnect {
                              {configuration::AssetTopic, "MTConnect/Asset/"s},
                              {configuration::ObservationTopic, "MTConnect/Observation/"s},
                              {configuration::MqttPort, 1883},
-                             {configuration::MqttTls, false}});
+                             {configuration::MqttTls, false},
+                             {configuration::SinkQueueSize, 1024},
+                             {configuration::SinkQueuePolicy, "block"s}});
+
+        // Publish observations on their own strand so a slow broker does not hold up
+        // ingest.
+        makeQueue(m_context, m_options);
 
         auto clientHandler = make_unique<ClientHandler>();
         clientHandler->m_connected = [this](shared_ptr<MqttClient> client) {
@@ -77,7 +83,7 @@ namespace mtconnect {
           for (auto &obs : obsList)
           {
             observation::ObservationPtr p {obs.second};
-            publish(p);
+            deliver(p);
           }
 
           AssetList list;
@@ -113,6 +119,9 @@ namespace mtconnect {
 
       void MqttService::stop()
       {
+        if (m_queue)
+          m_queue->stop();
+
         // stop client side
         if (m_client)
           m_client->stop();
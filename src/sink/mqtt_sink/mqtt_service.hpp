@@ -47,7 +47,12 @@ namespace mtconnect {
         MqttService(boost::asio::io_context &context, sink::SinkContractPtr &&contract,
                     const ConfigOptions &options, const boost::property_tree::ptree &config);
 
-        ~MqttService() = default;
+        ~MqttService()
+        {
+          // Wait for queued publication before the members it uses are destroyed
+          if (m_queue)
+            m_queue->stop();
+        }
 
         // Sink Methods
         void start() override;
@@ -0,0 +1,120 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mtconnect::sink::rest_sink {
+  // Token bucket rate limiter keyed by the remote address of the client. Each client
+  // may burst up to burst requests and is then refilled at rate requests per second.
+  class RateLimiter
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    RateLimiter(double rate, double burst, size_t maxClients = 1024)
+      : m_rate(rate), m_burst(std::max(burst, 1.0)), m_maxClients(std::max(maxClients, size_t(1)))
+    {}
+
+    // Consume cost tokens for the client, returns false if the bucket is exhausted
+    bool admit(const std::string &client, double cost = 1.0)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      auto now = Clock::now();
+      auto it = m_buckets.find(client);
+      if (it == m_buckets.end())
+      {
+        if (m_buckets.size() >= m_maxClients)
+          prune(now);
+        it = m_buckets.emplace(client, Bucket {m_burst, now}).first;
+      }
+
+      auto &bucket = it->second;
+      std::chrono::duration<double> elapsed = now - bucket.m_last;
+      bucket.m_tokens = std::min(m_burst, bucket.m_tokens + elapsed.count() * m_rate);
+      bucket.m_last = now;
+
+      if (bucket.m_tokens < cost)
+        return false;
+
+      bucket.m_tokens -= cost;
+      return true;
+    }
+
+    auto getRate() const { return m_rate; }
+    auto getBurst() const { return m_burst; }
+    size_t getClientCount() const
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_buckets.size();
+    }
+
+  protected:
+    struct Bucket
+    {
+      double m_tokens;
+      Clock::time_point m_last;
+    };
+
+    // Remove clients whose buckets have refilled completely, they are indistinguishable
+    // from new clients. If that is not enough, evict the least recently seen clients down
+    // to 7/8 of the cap so the scan is not repeated for every new client.
+    void prune(const Clock::time_point &now)
+    {
+      for (auto it = m_buckets.begin(); it != m_buckets.end();)
+      {
+        std::chrono::duration<double> elapsed = now - it->second.m_last;
+        if (it->second.m_tokens + elapsed.count() * m_rate >= m_burst)
+          it = m_buckets.erase(it);
+        else
+          it++;
+      }
+
+      if (m_buckets.size() < m_maxClients)
+        return;
+
+      using Iterator = decltype(m_buckets)::iterator;
+      std::vector<Iterator> entries;
+      entries.reserve(m_buckets.size());
+      for (auto it = m_buckets.begin(); it != m_buckets.end(); it++)
+        entries.push_back(it);
+
+      auto evict = m_buckets.size() - m_maxClients * 7 / 8;
+      std::nth_element(entries.begin(), entries.begin() + (evict - 1), entries.end(),
+                       [](const Iterator &a, const Iterator &b) {
+                         return a->second.m_last < b->second.m_last;
+                       });
+      for (size_t i = 0; i < evict; i++)
+        m_buckets.erase(entries[i]);
+    }
+
+  protected:
+    double m_rate;
+    double m_burst;
+    size_t m_maxClients;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Bucket> m_buckets;
+  };
+}  // namespace mtconnect::sink::rest_sink
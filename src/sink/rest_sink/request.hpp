@@ -51,6 +51,7 @@ namespace mtconnect::sink::rest_sink {
     std::string m_accepts;
     std::string m_acceptsEncoding;
     std::string m_contentType;
+    std::optional<std::string> m_ifNoneMatch;
     std::string m_path;
     std::string m_foreignIp;
     uint16_t m_foreignPort;
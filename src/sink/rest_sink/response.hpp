@@ -50,6 +50,7 @@ namespace mtconnect {
       std::string m_body;
       std::string m_mimeType;
       std::optional<std::string> m_location;
+      std::optional<std::string> m_etag;
       std::chrono::seconds m_expires;
       bool m_close {false};
 
@@ -46,7 +46,8 @@ namespace mtconnect {
         m_strand(context),
         m_schemaVersion(GetOption<string>(options, config::SchemaVersion).value_or("x.y")),
         m_options(options),
-        m_logStreamData(GetOption<bool>(options, config::LogStreams).value_or(false))
+        m_logStreamData(GetOption<bool>(options, config::LogStreams).value_or(false)),
+        m_maxSampleCount(GetOption<int>(options, config::MaxSampleCount).value_or(0))
     {
       auto maxSize =
           ConvertFileSize(options, mtconnect::configuration::MaxCachedFileSize, 20 * 1024);
@@ -548,7 +549,8 @@ namespace mtconnect {
           respond(session, currentRequest(printerForAccepts(request->m_accepts),
                                           request->parameter<string>("device"),
                                           request->parameter<uint64_t>("at"),
-                                          request->parameter<string>("path")));
+                                          request->parameter<string>("path"),
+                                          request->m_ifNoneMatch));
         }
         return true;
       };
@@ -668,10 +670,50 @@ namespace mtconnect {
           printer->mimeType());
     }
 
+    static inline size_t hashFilter(const Printer *printer, const FilterSetOpt &filter)
+    {
+      size_t seed = std::hash<string>()(printer->mimeType());
+      if (filter)
+      {
+        for (const auto &id : *filter)
+          seed ^= std::hash<string>()(id) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      }
+      return seed;
+    }
+
+    // If-None-Match is * or a list of entity tags. The comparison is weak, so W/ is ignored.
+    static bool matchesEntityTag(const string &ifNoneMatch, const string &etag)
+    {
+      size_t pos = 0;
+      while (pos < ifNoneMatch.size())
+      {
+        auto end = ifNoneMatch.find(',', pos);
+        if (end == string::npos)
+          end = ifNoneMatch.size();
+
+        auto b = ifNoneMatch.find_first_not_of(" \t", pos);
+        auto e = ifNoneMatch.find_last_not_of(" \t", end - 1);
+        if (b < end && e != string::npos && e >= b)
+        {
+          string_view tag(ifNoneMatch.data() + b, e - b + 1);
+          if (tag == "*")
+            return true;
+          if (tag.substr(0, 2) == "W/")
+            tag.remove_prefix(2);
+          if (tag == etag)
+            return true;
+        }
+        pos = end + 1;
+      }
+
+      return false;
+    }
+
     ResponsePtr RestService::currentRequest(const Printer *printer,
                                             const std::optional<std::string> &device,
                                             const std::optional<SequenceNumber_t> &at,
-                                            const std::optional<std::string> &path)
+                                            const std::optional<std::string> &path,
+                                            const std::optional<std::string> &ifNoneMatch)
     {
       using namespace rest_sink;
       DevicePtr dev {nullptr};
@@ -686,9 +728,69 @@ namespace mtconnect {
         checkPath(printer, path, dev, *filter);
       }
 
-      // Check if there is a frequency to stream data or not
-      return make_unique<Response>(rest_sink::status::ok, fetchCurrentData(printer, filter, at),
-                                   printer->mimeType());
+      if (at)
+      {
+        return make_unique<Response>(rest_sink::status::ok, fetchCurrentData(printer, filter, at),
+                                     printer->mimeType());
+      }
+
+      // The current document only changes when the buffer sequence advances, reuse the
+      // last rendered document and let the client revalidate with the ETag.
+      auto hash = hashFilter(printer, filter);
+      auto etag = [this, hash](SequenceNumber_t seq) {
+        stringstream str;
+        str << '"' << m_instanceId << '-' << seq << '-' << hex << hash << '"';
+        return str.str();
+      };
+
+      auto seq = getSequence();
+      if (ifNoneMatch && matchesEntityTag(*ifNoneMatch, etag(seq)))
+      {
+        auto response = make_unique<Response>(rest_sink::status::not_modified, "",
+                                              printer->mimeType());
+        response->m_etag = etag(seq);
+        return response;
+      }
+
+      CurrentKey key {printer, hash};
+      string body;
+      {
+        std::lock_guard<std::mutex> lock(m_currentCacheMutex);
+        auto cached = m_currentCache.find(key);
+        if (cached != m_currentCache.end())
+        {
+          m_currentLru.splice(m_currentLru.begin(), m_currentLru, cached->second);
+          if (cached->second->m_sequence == seq && cached->second->m_filter == filter)
+            body = cached->second->m_body;
+        }
+      }
+
+      if (body.empty())
+      {
+        body = fetchCurrentData(printer, filter, nullopt, &seq);
+
+        std::lock_guard<std::mutex> lock(m_currentCacheMutex);
+        auto cached = m_currentCache.find(key);
+        if (cached != m_currentCache.end())
+        {
+          *cached->second = CachedCurrent {key, seq, filter, body};
+          m_currentLru.splice(m_currentLru.begin(), m_currentLru, cached->second);
+        }
+        else
+        {
+          if (m_currentCache.size() >= m_maxCurrentCache)
+          {
+            m_currentCache.erase(m_currentLru.back().m_key);
+            m_currentLru.pop_back();
+          }
+          m_currentLru.push_front(CachedCurrent {key, seq, filter, body});
+          m_currentCache.emplace(key, m_currentLru.begin());
+        }
+      }
+
+      auto response = make_unique<Response>(rest_sink::status::ok, body, printer->mimeType());
+      response->m_etag = etag(seq);
+      return response;
     }
 
     ResponsePtr RestService::sampleRequest(const Printer *printer, const int count,
@@ -709,6 +811,7 @@ namespace mtconnect {
         filter = make_optional<FilterSet>();
         checkPath(printer, path, dev, *filter);
       }
+      checkAdmission(printer, count);
 
       // Check if there is a frequency to stream data or not
       SequenceNumber_t end;
@@ -719,16 +822,20 @@ namespace mtconnect {
           fetchSampleData(printer, filter, count, from, to, end, endOfBuffer), printer->mimeType());
     }
 
+    // Each streaming response owns its own strand so that independent streams can
+    // format and write in parallel across the worker threads.
     struct AsyncSampleResponse
     {
-      AsyncSampleResponse(rest_sink::SessionPtr &session, boost::asio::io_context::strand &strand)
+      AsyncSampleResponse(rest_sink::SessionPtr &session, boost::asio::io_context &context)
         : m_session(session),
-          m_observer(strand),
+          m_strand(context),
+          m_observer(m_strand),
           m_last(chrono::system_clock::now()),
-          m_timer(strand.context())
+          m_timer(context)
       {}
 
       rest_sink::SessionPtr m_session;
+      boost::asio::io_context::strand m_strand;
       ofstream m_log;
       SequenceNumber_t m_sequence {0};
       chrono::milliseconds m_interval;
@@ -763,12 +870,13 @@ namespace mtconnect {
         dev = checkDevice(printer, *device);
       }
 
-      auto asyncResponse = make_shared<AsyncSampleResponse>(session, m_strand);
+      auto asyncResponse = make_shared<AsyncSampleResponse>(session, m_context);
       asyncResponse->m_count = count;
       asyncResponse->m_printer = printer;
       asyncResponse->m_heartbeat = std::chrono::milliseconds(heartbeatIn);
 
       checkPath(asyncResponse->m_printer, path, dev, asyncResponse->m_filter);
+      checkAdmission(printer, count);
 
       if (m_logStreamData)
       {
@@ -797,8 +905,9 @@ namespace mtconnect {
 
       session->beginStreaming(
           printer->mimeType(),
-          asio::bind_executor(
-              m_strand, boost::bind(&RestService::streamSampleWriteComplete, this, asyncResponse)));
+          asio::bind_executor(asyncResponse->m_strand,
+                              boost::bind(&RestService::streamSampleWriteComplete, this,
+                                          asyncResponse)));
     }
 
     void RestService::streamSampleWriteComplete(shared_ptr<AsyncSampleResponse> asyncResponse)
@@ -813,8 +922,9 @@ namespace mtconnect {
 
         asyncResponse->m_observer.wait(
             asyncResponse->m_heartbeat,
-            asio::bind_executor(m_strand, boost::bind(&RestService::streamNextSampleChunk, this,
-                                                      asyncResponse, _1)));
+            asio::bind_executor(asyncResponse->m_strand,
+                                boost::bind(&RestService::streamNextSampleChunk, this,
+                                            asyncResponse, _1)));
       }
       else
       {
@@ -874,7 +984,7 @@ namespace mtconnect {
           {
             asyncResponse->m_timer.expires_from_now(asyncResponse->m_interval - delta);
             asyncResponse->m_timer.async_wait(asio::bind_executor(
-                m_strand,
+                asyncResponse->m_strand,
                 boost::bind(&RestService::streamNextSampleChunk, this, asyncResponse, _1)));
             return;
           }
@@ -886,60 +996,62 @@ namespace mtconnect {
           asyncResponse->m_sequence = asyncResponse->m_observer.getSequence();
           asyncResponse->m_observer.reset();
         }
+      }
 
-        // Fetch sample data now resets the observer while holding the sequence
-        // mutex to make sure that a new event will be recorded in the observer
-        // when it returns.
-        uint64_t end(0ull);
-        string content;
-        asyncResponse->m_endOfBuffer = true;
-
-        // Check if we're falling too far behind. If we are, generate an
-        // MTConnectError and return.
-        if (asyncResponse->m_sequence < getFirstSequence())
-        {
-          LOG(warning) << "Client fell too far behind, disconnecting";
-          asyncResponse->m_session->fail(boost::beast::http::status::not_found,
-                                         "Client fell too far behind, disconnecting");
-          return;
-        }
+      // Fetch sample data now resets the observer while holding the sequence
+      // mutex to make sure that a new event will be recorded in the observer
+      // when it returns. The document is printed after the mutex is released so
+      // ingest is not blocked while the response is formatted.
+      uint64_t end(0ull);
+      string content;
+      asyncResponse->m_endOfBuffer = true;
+
+      // Check if we're falling too far behind. If we are, generate an
+      // MTConnectError and return.
+      if (asyncResponse->m_sequence < getFirstSequence())
+      {
+        LOG(warning) << "Client fell too far behind, disconnecting";
+        asyncResponse->m_session->fail(boost::beast::http::status::not_found,
+                                       "Client fell too far behind, disconnecting");
+        return;
+      }
 
-        // end and endOfBuffer are set during the fetch sample data while the
-        // mutex is held. This removed the race to check if we are at the end of
-        // the bufffer and setting the next start to the last sequence number
-        // sent.
-        content = fetchSampleData(asyncResponse->m_printer, asyncResponse->m_filter,
-                                  asyncResponse->m_count, asyncResponse->m_sequence, nullopt, end,
-                                  asyncResponse->m_endOfBuffer, &asyncResponse->m_observer);
-
-        // Even if we are at the end of the buffer, or within range. If we are filtering,
-        // we will need to make sure we are not spinning when there are no valid events
-        // to be reported. we will waste cycles spinning on the end of the buffer when
-        // we should be in a heartbeat wait as well.
-        if (!asyncResponse->m_endOfBuffer)
-        {
-          // If we're not at the end of the buffer, move to the end of the previous set and
-          // begin filtering from where we left off.
-          asyncResponse->m_sequence = end;
-        }
+      // end and endOfBuffer are set during the fetch sample data while the
+      // mutex is held. This removed the race to check if we are at the end of
+      // the bufffer and setting the next start to the last sequence number
+      // sent.
+      content = fetchSampleData(asyncResponse->m_printer, asyncResponse->m_filter,
+                                asyncResponse->m_count, asyncResponse->m_sequence, nullopt, end,
+                                asyncResponse->m_endOfBuffer, &asyncResponse->m_observer);
+
+      // Even if we are at the end of the buffer, or within range. If we are filtering,
+      // we will need to make sure we are not spinning when there are no valid events
+      // to be reported. we will waste cycles spinning on the end of the buffer when
+      // we should be in a heartbeat wait as well.
+      if (!asyncResponse->m_endOfBuffer)
+      {
+        // If we're not at the end of the buffer, move to the end of the previous set and
+        // begin filtering from where we left off.
+        asyncResponse->m_sequence = end;
+      }
 
-        if (m_logStreamData)
-          asyncResponse->m_log << content << endl;
+      if (m_logStreamData)
+        asyncResponse->m_log << content << endl;
 
-        asyncResponse->m_session->writeChunk(
-            content,
-            asio::bind_executor(m_strand, boost::bind(&RestService::streamSampleWriteComplete, this,
-                                                      asyncResponse)));
-      }
+      asyncResponse->m_session->writeChunk(
+          content, asio::bind_executor(asyncResponse->m_strand,
+                                       boost::bind(&RestService::streamSampleWriteComplete, this,
+                                                   asyncResponse)));
     }
 
     struct AsyncCurrentResponse
     {
       AsyncCurrentResponse(rest_sink::SessionPtr session, asio::io_context &context)
-        : m_session(session), m_timer(context)
+        : m_session(session), m_strand(context), m_timer(context)
       {}
 
       rest_sink::SessionPtr m_session;
+      boost::asio::io_context::strand m_strand;
       chrono::milliseconds m_interval;
       const Printer *m_printer {nullptr};
       FilterSetOpt m_filter;
@@ -968,7 +1080,8 @@ namespace mtconnect {
       asyncResponse->m_printer = printer;
 
       asyncResponse->m_session->beginStreaming(
-          printer->mimeType(), boost::asio::bind_executor(m_strand, [this, asyncResponse]() {
+          printer->mimeType(),
+          boost::asio::bind_executor(asyncResponse->m_strand, [this, asyncResponse]() {
             streamNextCurrent(asyncResponse, boost::system::error_code {});
           }));
     }
@@ -996,10 +1109,11 @@ namespace mtconnect {
 
       asyncResponse->m_session->writeChunk(
           fetchCurrentData(asyncResponse->m_printer, asyncResponse->m_filter, nullopt),
-          boost::asio::bind_executor(m_strand, [this, asyncResponse]() {
+          boost::asio::bind_executor(asyncResponse->m_strand, [this, asyncResponse]() {
             asyncResponse->m_timer.expires_from_now(asyncResponse->m_interval);
             asyncResponse->m_timer.async_wait(boost::asio::bind_executor(
-                m_strand, boost::bind(&RestService::streamNextCurrent, this, asyncResponse, _1)));
+                asyncResponse->m_strand,
+                boost::bind(&RestService::streamNextCurrent, this, asyncResponse, _1)));
           }));
     }
 
@@ -1160,12 +1274,10 @@ namespace mtconnect {
       Timestamp ts;
       if (time)
       {
-        istringstream in(*time);
-        in >> std::setw(6) >> date::parse("%FT%T", ts);
-        if (!in.good())
-        {
+        if (auto parsed = parseTimestamp(*time))
+          ts = *parsed;
+        else
           ts = chrono::system_clock::now();
-        }
       }
       else
       {
@@ -1280,6 +1392,27 @@ namespace mtconnect {
       }
     }
 
+    void RestService::checkAdmission(const Printer *printer, const int count) const
+    {
+      if (m_maxSampleCount <= 0)
+        return;
+
+      // Estimate the number of observations the response can carry. A sample document
+      // never contains more than count observations or more than the buffer holds,
+      // filtering only reduces the result.
+      auto buffer = int64_t(m_sinkContract->getCircularBuffer().getBufferSize());
+      int64_t estimate = std::min<int64_t>(std::abs(count), buffer);
+
+      if (estimate > m_maxSampleCount)
+      {
+        stringstream str;
+        str << "Request for " << estimate << " observations exceeds the limit of "
+            << m_maxSampleCount << ", reduce the count or narrow the path";
+        throw RequestError(str.str().c_str(), printError(printer, "TOO_MANY", str.str()),
+                           printer->mimeType(), status::too_many_requests);
+      }
+    }
+
     void RestService::checkPath(const Printer *printer, const std::optional<std::string> &path,
                                 const DevicePtr device, FilterSet &filter) const
     {
@@ -1319,7 +1452,8 @@ namespace mtconnect {
     // -------------------------------------------
 
     string RestService::fetchCurrentData(const Printer *printer, const FilterSetOpt &filterSet,
-                                         const optional<SequenceNumber_t> &at)
+                                         const optional<SequenceNumber_t> &at,
+                                         SequenceNumber_t *sequence)
     {
       ObservationList observations;
       SequenceNumber_t firstSeq, seq;
@@ -1342,6 +1476,9 @@ namespace mtconnect {
         }
       }
 
+      if (sequence)
+        *sequence = seq;
+
       return printer->printSample(m_instanceId, m_sinkContract->getCircularBuffer().getBufferSize(),
                                   seq, firstSeq, seq - 1, observations);
     }
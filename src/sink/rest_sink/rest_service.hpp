@@ -19,6 +19,9 @@
 
 #include "boost/asio/io_context.hpp"
 
+#include <list>
+#include <map>
+
 #include "buffer/circular_buffer.hpp"
 #include "request.hpp"
 #include "response.hpp"
@@ -87,7 +90,8 @@ namespace mtconnect {
       ResponsePtr currentRequest(const printer::Printer *,
                                  const std::optional<std::string> &device = std::nullopt,
                                  const std::optional<SequenceNumber_t> &at = std::nullopt,
-                                 const std::optional<std::string> &path = std::nullopt);
+                                 const std::optional<std::string> &path = std::nullopt,
+                                 const std::optional<std::string> &ifNoneMatch = std::nullopt);
 
       ResponsePtr sampleRequest(const printer::Printer *, const int count = 100,
                                 const std::optional<std::string> &device = std::nullopt,
@@ -183,7 +187,8 @@ namespace mtconnect {
 
       // Current Data Collection
       std::string fetchCurrentData(const printer::Printer *printer, const FilterSetOpt &filterSet,
-                                   const std::optional<SequenceNumber_t> &at);
+                                   const std::optional<SequenceNumber_t> &at,
+                                   SequenceNumber_t *sequence = nullptr);
 
       // Sample data collection
       std::string fetchSampleData(const printer::Printer *printer, const FilterSetOpt &filterSet,
@@ -202,6 +207,9 @@ namespace mtconnect {
 
       DevicePtr checkDevice(const printer::Printer *printer, const std::string &uuid) const;
 
+      // Reject sample requests whose estimated response exceeds MaxSampleCount
+      void checkAdmission(const printer::Printer *printer, const int count) const;
+
     protected:
       // Loopback
       boost::asio::io_context &m_context;
@@ -222,6 +230,25 @@ namespace mtconnect {
       FileCache m_fileCache;
 
       bool m_logStreamData {false};
+
+      // Admission control, 0 disables the limit
+      int m_maxSampleCount {0};
+
+      // Rendered current documents keyed by printer and filter hash. An entry is
+      // only valid while the buffer sequence has not advanced. The least recently used
+      // entry is evicted when the cache is full.
+      using CurrentKey = std::pair<const printer::Printer *, size_t>;
+      struct CachedCurrent
+      {
+        CurrentKey m_key;
+        SequenceNumber_t m_sequence;
+        FilterSetOpt m_filter;
+        std::string m_body;
+      };
+      std::mutex m_currentCacheMutex;
+      std::list<CachedCurrent> m_currentLru;
+      std::map<CurrentKey, std::list<CachedCurrent>::iterator> m_currentCache;
+      size_t m_maxCurrentCache {64};
     };
   }  // namespace sink::rest_sink
 }  // namespace mtconnect
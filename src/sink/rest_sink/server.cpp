@@ -188,8 +188,7 @@ namespace mtconnect::sink::rest_sink {
 
         if (m_lastSession)
           m_lastSession(session);
-        dispatch(session, request);
-        return true;
+        return dispatch(session, request);
       };
       if (m_tlsEnabled)
       {
@@ -35,6 +35,7 @@
 
 #include "configuration/config_options.hpp"
 #include "file_cache.hpp"
+#include "rate_limiter.hpp"
 #include "response.hpp"
 #include "routing.hpp"
 #include "session.hpp"
@@ -66,6 +67,13 @@ namespace mtconnect::sink::rest_sink {
       if (fields)
         setHttpHeaders(*fields);
 
+      auto rate = GetOption<double>(options, configuration::MaxRequestRate);
+      if (rate && *rate > 0.0)
+      {
+        auto burst = GetOption<int>(options, configuration::MaxRequestBurst).value_or(10);
+        m_rateLimiter = std::make_unique<RateLimiter>(*rate, double(burst));
+      }
+
       m_errorFunction = [](SessionPtr session, status st, const std::string &msg) {
         ResponsePtr response = std::make_unique<Response>(st, msg, "text/plain");
         session->writeFailureResponse(move(response));
@@ -114,8 +122,20 @@ namespace mtconnect::sink::rest_sink {
       return m_allowPutsFrom.find(addr) != m_allowPutsFrom.end();
     }
 
+    // Returns false only if no routing matches the request. Requests answered with an error
+    // response, such as a 429 or a request error, were handled.
     bool dispatch(SessionPtr session, RequestPtr request)
     {
+      if (m_rateLimiter && !m_rateLimiter->admit(request->m_foreignIp))
+      {
+        std::stringstream txt;
+        txt << request->m_foreignIp << ": Too many requests, rate limit of "
+            << m_rateLimiter->getRate() << "/s exceeded";
+        LOG(warning) << txt.str();
+        session->fail(boost::beast::http::status::too_many_requests, txt.str());
+        return true;
+      }
+
       try
       {
         for (auto &r : m_routings)
@@ -128,6 +148,7 @@ namespace mtconnect::sink::rest_sink {
         txt << session->getRemote().address() << ": Cannot find handler for: " << request->m_verb
             << " " << request->m_path;
         session->fail(boost::beast::http::status::not_found, txt.str());
+        return false;
       }
       catch (RequestError &re)
       {
@@ -157,7 +178,7 @@ namespace mtconnect::sink::rest_sink {
         session->fail(boost::beast::http::status::not_found, txt.str());
       }
 
-      return false;
+      return true;
     }
 
     void accept(boost::system::error_code ec, boost::asio::ip::tcp::socket soc);
@@ -165,6 +186,8 @@ namespace mtconnect::sink::rest_sink {
     void addRouting(const Routing &routing) { m_routings.emplace_back(routing); }
     void setErrorFunction(const ErrorFunction &func) { m_errorFunction = func; }
     ErrorFunction getErrorFunction() const { return m_errorFunction; }
+    void setRateLimiter(std::unique_ptr<RateLimiter> &&limiter) { m_rateLimiter = move(limiter); }
+    const RateLimiter *getRateLimiter() const { return m_rateLimiter.get(); }
 
     // Callback for testing. Allows test to grab the last session dispatched.
     std::function<void(SessionPtr)> m_lastSession;
@@ -190,6 +213,7 @@ namespace mtconnect::sink::rest_sink {
     std::unique_ptr<FileCache> m_fileCache;
     ErrorFunction m_errorFunction;
     FieldList m_fields;
+    std::unique_ptr<RateLimiter> m_rateLimiter;
 
     boost::asio::ip::tcp::acceptor m_acceptor;
     boost::asio::ssl::context m_sslContext;
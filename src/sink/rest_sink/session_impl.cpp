@@ -226,6 +226,8 @@ namespace mtconnect::sink::rest_sink {
       m_request->m_contentType = string(a->value());
     if (auto a = msg.find(http::field::accept_encoding); a != msg.end())
       m_request->m_acceptsEncoding = string(a->value());
+    if (auto a = msg.find(http::field::if_none_match); a != msg.end())
+      m_request->m_ifNoneMatch = string(a->value());
     m_request->m_body = msg.body();
 
     if (auto f = msg.find(http::field::content_type);
@@ -352,7 +354,13 @@ namespace mtconnect::sink::rest_sink {
     res->set(http::field::server, "MTConnectAgent");
     if (response.m_close || m_close)
       res->set(http::field::connection, "close");
-    if (response.m_expires == 0s)
+    if (response.m_etag)
+    {
+      // Allow the client to keep the document, but it must revalidate on every use
+      res->set(http::field::etag, *response.m_etag);
+      res->set(http::field::cache_control, "no-cache");
+    }
+    else if (response.m_expires == 0s)
     {
       res->set(http::field::expires, "-1");
       res->set(http::field::cache_control, "no-store, max-age=0");
@@ -17,10 +17,34 @@
 
 #include "sink.hpp"
 
+#include "configuration/config_options.hpp"
 #include "logging.hpp"
 
 namespace mtconnect {
   namespace sink {
+    void Sink::makeQueue(boost::asio::io_context &context, const ConfigOptions &options)
+    {
+      auto size = GetOption<int>(options, configuration::SinkQueueSize).value_or(0);
+      if (size <= 0)
+      {
+        m_queue.reset();
+        return;
+      }
+
+      auto name = GetOption<std::string>(options, configuration::SinkQueuePolicy).value_or("block");
+      auto policy = SinkQueue::policyFor(name);
+      if (!policy)
+      {
+        LOG(warning) << "Sink " << m_name << ": unknown queue policy " << name
+                     << ", using block";
+        policy = SinkQueue::BLOCK;
+      }
+
+      m_queue = std::make_shared<SinkQueue>(
+          context, [this](observation::ObservationPtr &observation) { publish(observation); },
+          size, *policy);
+    }
+
     SinkPtr SinkFactory::make(const std::string &factoryName, const std::string &sinkName,
                               boost::asio::io_context &io, SinkContractPtr &&contract,
                               const ConfigOptions &options,
@@ -30,6 +30,7 @@
 #include "device_model/device.hpp"
 #include "observation/observation.hpp"
 #include "printer/printer.hpp"
+#include "sink_queue.hpp"
 
 namespace mtconnect {
   namespace printer {
@@ -85,7 +86,11 @@ namespace mtconnect {
       Sink(const std::string &name, SinkContractPtr &&contract)
         : m_sinkContract(std::move(contract)), m_name(name)
       {}
-      virtual ~Sink() = default;
+      virtual ~Sink()
+      {
+        if (m_queue)
+          m_queue->stop();
+      }
 
       virtual void start() = 0;
       virtual void stop() = 0;
@@ -94,11 +99,28 @@ namespace mtconnect {
       virtual bool publish(asset::AssetPtr asset) = 0;
       virtual bool publish(device_model::DevicePtr device) { return false; }
 
+      // Called from the ingest path. Queues the observation if the sink has a queue,
+      // otherwise publishes it inline.
+      bool deliver(observation::ObservationPtr &observation)
+      {
+        if (m_queue)
+          return m_queue->push(observation);
+        else
+          return publish(observation);
+      }
+
       const auto &getName() const { return m_name; }
+      const SinkQueuePtr &getQueue() const { return m_queue; }
+
+    protected:
+      // Create the observation queue from the SinkQueueSize and SinkQueuePolicy options.
+      // A size of 0 publishes observations inline.
+      void makeQueue(boost::asio::io_context &context, const ConfigOptions &options);
 
     protected:
       std::unique_ptr<SinkContract> m_sinkContract;
       std::string m_name;
+      SinkQueuePtr m_queue;
     };
 
     class SinkFactory
@@ -0,0 +1,227 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/io_context_strand.hpp>
+#include <boost/asio/post.hpp>
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "logging.hpp"
+#include "observation/observation.hpp"
+
+namespace mtconnect::sink {
+  // A bounded queue between the ingest path and a sink. Observations are queued and
+  // published on the sink's own strand, so a slow sink does not hold up the buffer.
+  //
+  // When the queue is full the policy decides what happens:
+  //  - BLOCK: the producer publishes the queued observations itself before queuing. Nothing
+  //    is lost and ingest runs at the speed of the sink.
+  //  - DROP: the oldest queued observation is discarded.
+  //  - COALESCE: an observation replaces the queued observation for the same data item,
+  //    keeping its place in the queue. If there is none, the oldest is discarded.
+  class SinkQueue : public std::enable_shared_from_this<SinkQueue>
+  {
+  public:
+    enum Policy
+    {
+      BLOCK,
+      DROP,
+      COALESCE
+    };
+
+    using Publish = std::function<void(observation::ObservationPtr &)>;
+
+    SinkQueue(boost::asio::io_context &context, Publish publish, size_t capacity,
+              Policy policy = BLOCK)
+      : m_strand(context), m_publish(std::move(publish)), m_capacity(capacity), m_policy(policy)
+    {}
+
+    static std::optional<Policy> policyFor(const std::string &name)
+    {
+      if (name == "block")
+        return BLOCK;
+      else if (name == "drop")
+        return DROP;
+      else if (name == "coalesce")
+        return COALESCE;
+      else
+        return std::nullopt;
+    }
+
+    // Queue the observation for publication. Returns false if the queue has been stopped.
+    bool push(const observation::ObservationPtr &observation)
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (m_stopped)
+        return false;
+
+      if (m_policy == COALESCE && !observation->isOrphan())
+      {
+        auto &id = observation->getDataItem()->getId();
+        auto queued = m_index.find(id);
+        if (queued != m_index.end())
+        {
+          *(queued->second) = observation;
+          m_coalesced++;
+          return true;
+        }
+      }
+
+      if (m_queue.size() >= m_capacity)
+      {
+        if (m_policy == BLOCK)
+        {
+          lock.unlock();
+          drain();
+          lock.lock();
+
+          // The queue may have been stopped while it was unlocked
+          if (m_stopped)
+            return false;
+        }
+        else
+        {
+          if (!m_overflowing)
+          {
+            LOG(warning) << "Sink queue is full, discarding the oldest observations";
+            m_overflowing = true;
+          }
+          removeOldest();
+          m_dropped++;
+        }
+      }
+
+      m_queue.emplace_back(observation);
+      if (m_policy == COALESCE && !observation->isOrphan())
+        m_index[observation->getDataItem()->getId()] = std::prev(m_queue.end());
+
+      if (m_queue.size() > m_highWater)
+        m_highWater = m_queue.size();
+
+      if (!m_scheduled)
+      {
+        m_scheduled = true;
+        boost::asio::post(m_strand, [ptr = shared_from_this()]() { ptr->drain(); });
+      }
+
+      return true;
+    }
+
+    // Discards anything queued and stops publication. Waits for a publication in progress
+    // to finish, so the sink can be torn down once this returns. Must not be called from
+    // the publish function.
+    void stop()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = true;
+        m_queue.clear();
+        m_index.clear();
+      }
+
+      std::lock_guard<std::mutex> publishing(m_publishMutex);
+    }
+
+    // Queue depth metrics, published on the agent device for each sink with a queue
+    size_t size() const
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_queue.size();
+    }
+    size_t getHighWater() const
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_highWater;
+    }
+    size_t getDropped() const
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_dropped;
+    }
+    size_t getCoalesced() const
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_coalesced;
+    }
+    size_t getCapacity() const { return m_capacity; }
+    Policy getPolicy() const { return m_policy; }
+
+  protected:
+    // Publishes everything queued. Publication is serialized so the sink sees the
+    // observations in the order they were queued.
+    void drain()
+    {
+      std::lock_guard<std::mutex> publishing(m_publishMutex);
+
+      observation::ObservationList batch;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        batch.swap(m_queue);
+        m_index.clear();
+        m_scheduled = false;
+        m_overflowing = false;
+      }
+
+      for (auto &observation : batch)
+      {
+        if (m_stopped)
+          return;
+        m_publish(observation);
+      }
+    }
+
+    // Must be called with the queue locked
+    void removeOldest()
+    {
+      auto &oldest = m_queue.front();
+      if (m_policy == COALESCE && !oldest->isOrphan())
+        m_index.erase(oldest->getDataItem()->getId());
+      m_queue.pop_front();
+    }
+
+  protected:
+    boost::asio::io_context::strand m_strand;
+    Publish m_publish;
+    size_t m_capacity;
+    Policy m_policy;
+
+    mutable std::mutex m_mutex;
+    std::mutex m_publishMutex;
+    observation::ObservationList m_queue;
+    std::unordered_map<std::string, observation::ObservationList::iterator> m_index;
+    bool m_scheduled {false};
+    bool m_overflowing {false};
+    // Read without the queue lock between publications
+    std::atomic_bool m_stopped {false};
+
+    size_t m_highWater {0};
+    size_t m_dropped {0};
+    size_t m_coalesced {0};
+  };
+
+  using SinkQueuePtr = std::shared_ptr<SinkQueue>;
+}  // namespace mtconnect::sink
@@ -33,6 +33,8 @@ namespace mtconnect::source::adapter {
     const std::string &getIdentity() const override { return m_identity; }
     virtual unsigned int getPort() const = 0;
     virtual const ConfigOptions &getOptions() const { return m_options; }
+    // True if the adapter reports how far it is behind its upstream source
+    virtual bool reportsLag() const { return false; }
 
     void setHandler(std::unique_ptr<Handler> &h) { m_handler = std::move(h); }
 
@@ -59,10 +59,23 @@ namespace mtconnect {
                                           Properties {{"VALUE", "DISCONNECTED"s}, {"source", id}});
         run(entity);
       };
-      handler->m_processData = [this](const std::string &data, const std::string &source) {
-        auto entity = make_shared<Entity>("Data", Properties {{"VALUE", data}, {"source", source}});
+      handler->m_processData = [this](std::string data, const std::string &source) {
+        auto entity = make_shared<Entity>(
+            "Data", Properties {{"VALUE", std::move(data)}, {"source", source}});
         run(entity);
       };
+      handler->m_processLines = [this](std::list<std::string> &lines, const std::string &source) {
+        EntityList entities;
+        for (auto &line : lines)
+          entities.emplace_back(make_shared<Entity>(
+              "Data", Properties {{"VALUE", std::move(line)}, {"source", source}}));
+        EntityList results;
+        run(entities, results);
+      };
+      handler->m_processObservations = [this](EntityList &entities, const std::string &) {
+        EntityList results;
+        run(entities, results);
+      };
       handler->m_processMessage = [this](const std::string &topic, const std::string &data,
                                          const std::string &source) {
         auto entity = make_shared<PipelineMessage>(
@@ -119,14 +132,18 @@ namespace mtconnect {
       next->bind(make_shared<DeliverAssetCommand>(m_context));
     }
 
-    void AdapterPipeline::buildObservationDelivery(pipeline::TransformPtr next)
+    pipeline::TransformPtr AdapterPipeline::buildObservationDelivery(pipeline::TransformPtr next)
     {
+      TransformPtr first;
+
       // Uppercase Events
       if (IsOptionSet(m_options, configuration::UpcaseDataItemValue))
-        next = next->bind(make_shared<UpcaseValue>());
+        first = next = next->bind(make_shared<UpcaseValue>());
 
       // Filter dups, by delta, and by period
       next = next->bind(make_shared<DuplicateFilter>(m_context));
+      if (!first)
+        first = next;
       next = next->bind(make_shared<DeltaFilter>(m_context));
       next = next->bind(make_shared<PeriodFilter>(m_context, m_strand));
 
@@ -138,6 +155,8 @@ namespace mtconnect {
       std::optional<string> obsMetrics;
       obsMetrics = m_identity + "_observation_update_rate";
       next->bind(make_shared<DeliverObservation>(m_context, obsMetrics));
+
+      return first;
     }
   }  // namespace source::adapter
 }  // namespace mtconnect
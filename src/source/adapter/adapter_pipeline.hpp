@@ -23,14 +23,22 @@
 namespace mtconnect::source::adapter {
   struct Handler
   {
-    using ProcessData = std::function<void(const std::string &data, const std::string &source)>;
+    // Data is taken by value so large documents can be moved into the pipeline
+    using ProcessData = std::function<void(std::string data, const std::string &source)>;
+    using ProcessLines =
+        std::function<void(std::list<std::string> &lines, const std::string &source)>;
     using ProcessMessage = std::function<void(const std::string &topic, const std::string &data,
                                               const std::string &source)>;
+    using ProcessEntities =
+        std::function<void(entity::EntityList &entities, const std::string &source)>;
     using Connect = std::function<void(const std::string &source)>;
 
     ProcessData m_processData;
+    ProcessLines m_processLines;
     ProcessData m_command;
     ProcessMessage m_processMessage;
+    // Observations already mapped to data items, for example from binary SHDR frames
+    ProcessEntities m_processObservations;
 
     Connect m_connecting;
     Connect m_connected;
@@ -51,7 +59,8 @@ namespace mtconnect::source::adapter {
     void buildDeviceList();
     void buildCommandAndStatusDelivery();
     void buildAssetDelivery(pipeline::TransformPtr next);
-    void buildObservationDelivery(pipeline::TransformPtr next);
+    // Returns the first transform of the observation delivery
+    pipeline::TransformPtr buildObservationDelivery(pipeline::TransformPtr next);
 
   protected:
     ConfigOptions m_options;
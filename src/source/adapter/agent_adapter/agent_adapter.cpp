@@ -47,7 +47,8 @@ namespace mtconnect::source::adapter::agent_adapter {
     buildDeviceList();
     buildCommandAndStatusDelivery();
 
-    TransformPtr next = bind(make_shared<MTConnectXmlTransform>(m_context, m_feedback, m_device));
+    TransformPtr next = bind(make_shared<MTConnectXmlTransform>(m_context, m_feedback, m_device,
+                                                                m_identity + "_observation_lag"));
     std::optional<string> obsMetrics;
     obsMetrics = m_identity + "_observation_update_rate";
     next->bind(make_shared<DeliverObservation>(m_context, obsMetrics));
@@ -75,6 +76,8 @@ namespace mtconnect::source::adapter::agent_adapter {
                         {{configuration::Host, "localhost"s},
                          {configuration::Port, 5000},
                          {configuration::Count, 1000},
+                         {configuration::MaxCount, 10000},
+                         {configuration::MaxPartSize, 64 * 1024 * 1024},
                          {configuration::Heartbeat, 10000ms},
                          {configuration::PollingInterval, 500ms},
                          {configuration::AutoAvailable, false},
@@ -82,6 +85,7 @@ namespace mtconnect::source::adapter::agent_adapter {
                          {configuration::ReconnectInterval, 10000ms},
                          {configuration::RelativeTime, false},
                          {configuration::UsePolling, false},
+                         {configuration::UpstreamFormat, "xml"s},
                          {"!CloseConnectionAfterResponse!", false}});
 
     m_handler = m_pipeline.makeHandler();
@@ -107,9 +111,21 @@ namespace mtconnect::source::adapter::agent_adapter {
     m_usePolling = *GetOption<bool>(m_options, configuration::UsePolling);
     m_reconnectInterval = *GetOption<Milliseconds>(m_options, configuration::ReconnectInterval);
     m_pollingInterval = *GetOption<Milliseconds>(m_options, configuration::PollingInterval);
+    m_tuner = SampleTuner(m_count, *GetOption<int>(m_options, configuration::MaxCount),
+                          m_pollingInterval);
 
     m_closeConnectionAfterResponse = *GetOption<bool>(m_options, "!CloseConnectionAfterResponse!");
 
+    // Streams can be requested in the JSON or CBOR format, the response document parser
+    // decodes all of them. Assets are always requested as XML.
+    auto format = *GetOption<string>(m_options, configuration::UpstreamFormat);
+    if (format == "json")
+      m_accept = "application/mtconnect+json";
+    else if (format == "cbor")
+      m_accept = "application/mtconnect+cbor";
+    else if (format != "xml")
+      LOG(warning) << "Unknown upstream format: " << format << ", using xml";
+
     auto device = GetOption<string>(m_options, configuration::Device);
     if (!device)
     {
@@ -151,16 +167,10 @@ namespace mtconnect::source::adapter::agent_adapter {
 
     if (m_url.m_protocol == "https")
     {
-      // The SSL context is required, and holds certificates
-      m_streamContext = make_unique<ssl::context>(ssl::context::tlsv12_client);
-      m_streamContext->set_verify_mode(ssl::verify_none);
-
-      m_session = make_shared<HttpsSession>(m_strand, m_url, *m_streamContext);
-
-      m_assetContext = make_unique<ssl::context>(ssl::context::tlsv12_client);
-      m_assetContext->set_verify_mode(ssl::verify_none);
-
-      m_assetSession = make_shared<HttpsSession>(m_strand, m_url, *m_assetContext);
+      // All agent adapters share one TLS context and resume each other's sessions
+      auto tls = SharedTlsContext::get(m_strand.context());
+      m_session = make_shared<HttpsSession>(m_strand, m_url, tls);
+      m_assetSession = make_shared<HttpsSession>(m_strand, m_url, tls);
     }
     else if (m_url.m_protocol == "http")
     {
@@ -176,6 +186,8 @@ namespace mtconnect::source::adapter::agent_adapter {
     m_session->m_handler = m_handler.get();
     m_session->m_identity = m_identity;
     m_session->m_closeConnectionAfterResponse = m_closeConnectionAfterResponse;
+    m_session->m_accept = m_accept;
+    m_session->m_maxPartSize = size_t(*GetOption<int>(m_options, configuration::MaxPartSize));
     m_session->m_updateAssets = [this]() { updateAssets(); };
 
     m_assetSession->m_handler = m_handler.get();
@@ -207,6 +219,8 @@ namespace mtconnect::source::adapter::agent_adapter {
 
     m_feedback.m_instanceId = 0;
     m_feedback.m_next = 0;
+    m_feedback.m_last = 0;
+    m_tuner.reset();
   }
 
   void AgentAdapter::recoverStreams()
@@ -223,7 +237,10 @@ namespace mtconnect::source::adapter::agent_adapter {
     m_reconnectTimer.async_wait(asio::bind_executor(m_strand, [this](boost::system::error_code ec) {
       if (!ec)
       {
-        if (canRecover() && m_streamRequest)
+        // Samples are requested again from the next sequence with the tuned values
+        if (canRecover() && m_streamRequest && m_streamRequest->m_suffix == "sample")
+          sample();
+        else if (canRecover() && m_streamRequest)
           m_session->makeRequest(*m_streamRequest);
         else
           run();
@@ -376,9 +393,10 @@ namespace mtconnect::source::adapter::agent_adapter {
     {
       using namespace boost;
       UrlQuery query({{"from", lexical_cast<string>(m_feedback.m_next)},
-                      {"count", lexical_cast<string>(m_count)}});
+                      {"count", lexical_cast<string>(m_tuner.count())}});
       m_streamRequest.emplace(m_sourceDevice, "sample", query, false, [this]() {
-        m_pollingTimer.expires_after(m_pollingInterval);
+        tune();
+        m_pollingTimer.expires_after(m_tuner.interval());
         m_pollingTimer.async_wait(
             asio::bind_executor(m_strand, [this](boost::system::error_code ec) {
               if (!ec && m_streamRequest)
@@ -394,16 +412,36 @@ namespace mtconnect::source::adapter::agent_adapter {
     {
       using namespace boost;
       UrlQuery query({{"from", lexical_cast<string>(m_feedback.m_next)},
-                      {"count", lexical_cast<string>(m_count)},
+                      {"count", lexical_cast<string>(m_tuner.count())},
                       {"heartbeat", lexical_cast<string>(m_heartbeat.count())},
-                      {"interval", lexical_cast<string>(m_pollingInterval.count())}});
-      m_streamRequest.emplace(m_sourceDevice, "sample", query, true, nullptr);
+                      {"interval", lexical_cast<string>(m_tuner.interval().count())}});
+      // Reissue the stream from the next sequence when the tuned count or interval changes
+      m_streamRequest.emplace(m_sourceDevice, "sample", query, true, [this]() {
+        if (!tune())
+          return true;
+
+        sample();
+        return false;
+      });
       m_session->makeRequest(*m_streamRequest);
     }
 
     return true;
   }
 
+  bool AgentAdapter::tune()
+  {
+    auto lag = m_feedback.lag();
+    if (m_tuner.update(lag))
+    {
+      LOG(debug) << m_identity << ": " << lag << " observations behind, count "
+                 << m_tuner.count() << ", interval " << m_tuner.interval().count() << "ms";
+      return true;
+    }
+
+    return false;
+  }
+
   void AgentAdapter::stop()
   {
     m_stopped = true;
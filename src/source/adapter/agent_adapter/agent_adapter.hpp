@@ -18,15 +18,12 @@
 #pragma once
 
 #include "pipeline/mtconnect_xml_transform.hpp"
+#include "sample_tuner.hpp"
 #include "session.hpp"
 #include "source/adapter/adapter.hpp"
 #include "source/adapter/adapter_pipeline.hpp"
 #include "url_parser.hpp"
 
-namespace boost::asio::ssl {
-  class context;
-}
-
 namespace mtconnect::source::adapter::agent_adapter {
   using namespace mtconnect;
   using namespace source::adapter;
@@ -65,7 +62,9 @@ namespace mtconnect::source::adapter::agent_adapter {
     const std::string &getHost() const override { return m_host; }
 
     unsigned int getPort() const override { return 0; }
+    bool reportsLag() const override { return true; }
     auto &getFeedback() { return m_feedback; }
+    const auto &getTuner() const { return m_tuner; }
 
     ~AgentAdapter() override;
 
@@ -80,6 +79,7 @@ namespace mtconnect::source::adapter::agent_adapter {
     void recover();
     void current();
     bool sample();
+    bool tune();
     void assets();
     void updateAssets();
 
@@ -104,9 +104,11 @@ namespace mtconnect::source::adapter::agent_adapter {
     bool m_failed = false;
     bool m_stopped = false;
     bool m_usePolling = false;
+    std::string m_accept;
 
     std::chrono::milliseconds m_reconnectInterval;
     std::chrono::milliseconds m_pollingInterval;
+    SampleTuner m_tuner {1000, 1000, std::chrono::milliseconds(500)};
     std::string m_host;
     std::string m_sourceDevice;
     std::string m_feedbackId;
@@ -116,9 +118,6 @@ namespace mtconnect::source::adapter::agent_adapter {
     boost::asio::steady_timer m_pollingTimer;
     boost::asio::steady_timer m_assetRetryTimer;
 
-    std::unique_ptr<boost::asio::ssl::context> m_streamContext;
-    std::unique_ptr<boost::asio::ssl::context> m_assetContext;
-
     // Current and Asset Request
     std::optional<Session::Request> m_streamRequest;
     std::optional<Session::Request> m_assetRequest;
@@ -21,6 +21,7 @@
 #include <boost/beast/ssl.hpp>
 
 #include "session_impl.hpp"
+#include "shared_tls_context.hpp"
 
 namespace mtconnect::source::adapter::agent_adapter {
 
@@ -30,8 +31,12 @@ namespace mtconnect::source::adapter::agent_adapter {
   public:
     using super = SessionImpl<HttpsSession>;
 
-    explicit HttpsSession(boost::asio::io_context::strand &ex, const Url &url, ssl::context &ctx)
-      : super(ex, url), m_stream(ex.context(), ctx)
+    explicit HttpsSession(boost::asio::io_context::strand &ex, const Url &url,
+                          std::shared_ptr<SharedTlsContext> tls)
+      : super(ex, url),
+        m_tls(std::move(tls)),
+        m_stream(ex.context(), m_tls->context()),
+        m_upstream(m_url.getHost() + ":" + m_url.getService())
     {}
     ~HttpsSession()
     {
@@ -57,6 +62,7 @@ namespace mtconnect::source::adapter::agent_adapter {
         LOG(error) << "Cannot set TLS host name: " << ec.category().name() << " " << ec.message();
         return failed(source::make_error_code(ErrorCode::ADAPTER_FAILED), "tls host name");
       }
+      m_tls->resume(m_stream.native_handle(), m_upstream);
 
       super::connect();
     }
@@ -96,6 +102,11 @@ namespace mtconnect::source::adapter::agent_adapter {
         return failed(source::make_error_code(ErrorCode::ADAPTER_FAILED), "handshake");
       }
 
+      if (SSL_session_reused(m_stream.native_handle()))
+        LOG(debug) << "Resumed TLS session with " << m_upstream;
+      else
+        m_tls->save(m_stream.native_handle(), m_upstream);
+
       if (m_handler && m_handler->m_connected)
         m_handler->m_connected(m_identity);
 
@@ -137,7 +148,8 @@ namespace mtconnect::source::adapter::agent_adapter {
     }
 
   protected:
+    std::shared_ptr<SharedTlsContext> m_tls;
     beast::ssl_stream<beast::tcp_stream> m_stream;
-    optional<ssl::context> m_sslContext;
+    std::string m_upstream;
   };
 }  // namespace mtconnect::source::adapter::agent_adapter
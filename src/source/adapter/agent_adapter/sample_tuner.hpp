@@ -0,0 +1,80 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+#include "utilities.hpp"
+
+namespace mtconnect::source::adapter::agent_adapter {
+  // Adjusts the count and interval of sample requests using the number of observations
+  // the upstream agent has buffered past the next sequence we asked for. The interval is
+  // never lowered below an eighth of the configured interval.
+  class SampleTuner
+  {
+  public:
+    SampleTuner(int count, int maxCount, std::chrono::milliseconds interval)
+      : m_baseCount(count),
+        m_maxCount(std::max(count, maxCount)),
+        m_baseInterval(interval),
+        m_minInterval(interval / 8),
+        m_count(count),
+        m_interval(interval)
+    {}
+
+    // Returns true if the count or interval changed.
+    bool update(SequenceNumber_t lag)
+    {
+      auto count = m_count;
+      auto interval = m_interval;
+
+      if (lag >= SequenceNumber_t(m_count) && m_count < m_maxCount)
+      {
+        // More is buffered than one response can carry, ask for more, sooner. Once the
+        // count is capped the request stays as it is.
+        m_count = std::min(m_count * 2, m_maxCount);
+        m_interval = std::max(m_interval / 2, m_minInterval);
+      }
+      else if (lag == 0)
+      {
+        m_count = m_baseCount;
+        m_interval = m_baseInterval;
+      }
+
+      return count != m_count || interval != m_interval;
+    }
+
+    void reset()
+    {
+      m_count = m_baseCount;
+      m_interval = m_baseInterval;
+    }
+
+    int count() const { return m_count; }
+    std::chrono::milliseconds interval() const { return m_interval; }
+
+  protected:
+    int m_baseCount;
+    int m_maxCount;
+    std::chrono::milliseconds m_baseInterval;
+    std::chrono::milliseconds m_minInterval;
+
+    int m_count;
+    std::chrono::milliseconds m_interval;
+  };
+}  // namespace mtconnect::source::adapter::agent_adapter
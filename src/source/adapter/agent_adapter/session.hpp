@@ -54,6 +54,8 @@ namespace mtconnect::source::adapter::agent_adapter {
       std::string m_suffix;
       UrlQuery m_query;
       bool m_stream;
+      // Called when a response is complete, or after each part of a stream. A stream ends
+      // when it returns false.
       Next m_next;
 
       auto getTarget(const Url &url) { return url.getTarget(m_sourceDevice, m_suffix, m_query); }
@@ -71,7 +73,11 @@ namespace mtconnect::source::adapter::agent_adapter {
     Failure m_failed;
     UpdateAssets m_updateAssets;
     bool m_closeConnectionAfterResponse = false;
+    // The upstream agent picks its printer from the Accept header
+    std::string m_accept;
     std::chrono::milliseconds m_timeout = std::chrono::milliseconds(30000);
+    // Largest multipart stream part accepted from the upstream agent
+    size_t m_maxPartSize = 64 * 1024 * 1024;
   };
 
 }  // namespace mtconnect::source::adapter::agent_adapter
@@ -24,6 +24,7 @@
 #include <boost/beast/http.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/version.hpp>
+#include <boost/lexical_cast.hpp>
 
 #include "pipeline/mtconnect_xml_transform.hpp"
 #include "pipeline/response_document.hpp"
@@ -50,7 +51,7 @@ namespace mtconnect::source::adapter::agent_adapter {
     // Objects are constructed with a strand to
     // ensure that handlers do not execute concurrently.
     SessionImpl(boost::asio::io_context::strand &strand, const Url &url)
-      : m_resolver(strand.context()), m_strand(strand), m_url(url), m_chunk(1 * 1024 * 1024)
+      : m_resolver(strand.context()), m_strand(strand), m_url(url)
     {}
 
     virtual ~SessionImpl() { stop(); }
@@ -85,8 +86,9 @@ namespace mtconnect::source::adapter::agent_adapter {
         m_req.reset();
         m_hasHeader = false;
         m_closeOnRead = false;
-        if (m_chunk.size() > 0)
-          m_chunk.consume(m_chunk.size());
+        m_endStream = false;
+        m_header.clear();
+        m_part.clear();
 
         // Check if we are discussected.
         if (!derived().lowestLayer().socket().is_open())
@@ -108,12 +110,12 @@ namespace mtconnect::source::adapter::agent_adapter {
       }
     }
 
-    void processData(const std::string &data)
+    void processData(std::string &&data)
     {
       try
       {
         if (m_handler && m_handler->m_processData)
-          m_handler->m_processData(data, m_identity);
+          m_handler->m_processData(std::move(data), m_identity);
       }
       catch (std::system_error &e)
       {
@@ -213,6 +215,8 @@ namespace mtconnect::source::adapter::agent_adapter {
       m_req->set(http::field::host, m_url.getHost());
       m_req->set(http::field::user_agent, "MTConnect Agent/2.0");
       m_req->set(http::field::connection, "keep-alive");
+      if (!m_accept.empty())
+        m_req->set(http::field::accept, m_accept);
 
       if (m_closeConnectionAfterResponse)
       {
@@ -304,6 +308,9 @@ namespace mtconnect::source::adapter::agent_adapter {
 
       if (ec)
       {
+        if (m_endStream)
+          return endStream();
+
         LOG(error) << "Error getting response: " << ec.category().name() << " " << ec.message();
         return failed(source::make_error_code(ErrorCode::RETRY_REQUEST), "read");
       }
@@ -319,7 +326,7 @@ namespace mtconnect::source::adapter::agent_adapter {
       if (!derived().lowestLayer().socket().is_open())
         derived().disconnect();
 
-      processData(m_textParser->get().body());
+      processData(std::move(m_textParser->get().body()));
 
       m_textParser.reset();
       m_req.reset();
@@ -390,43 +397,34 @@ namespace mtconnect::source::adapter::agent_adapter {
       m_chunkParser->on_chunk_header(m_chunkHeaderHandler);
     }
 
+    // Parses the multipart header at the front of m_header. The header is removed and the
+    // part buffer is sized from the content length, returns false if more data is needed.
     bool parseMimeHeader()
     {
       using namespace boost;
       namespace algo = boost::algorithm;
 
-      if (m_chunk.data().size() < 128)
-      {
-        LOG(trace) << "Not enough data for mime header: " << m_chunk.data().size();
-        return false;
-      }
-
-      auto start = static_cast<const char *>(m_chunk.data().data());
-      boost::string_view view(start, m_chunk.data().size());
+      boost::string_view view(m_header.data(), m_header.size());
 
       auto bp = view.find(m_boundary.c_str());
-      if (bp == boost::string_view::npos)
+      auto ep = bp == boost::string_view::npos ? bp : view.find("\r\n\r\n", bp);
+      if (ep == boost::string_view::npos)
       {
-        LOG(warning) << "Cannot find the boundary";
-        derived().lowestLayer().close();
-        failed(source::make_error_code(source::ErrorCode::RESTART_STREAM),
-               "Framing error in streaming data: no content length");
-        return false;
-      }
+        if (view.size() < 1024)
+        {
+          LOG(trace) << "Not enough data for mime header: " << view.size();
+          return false;
+        }
 
-      auto ep = view.find("\r\n\r\n", bp);
-      if (bp == boost::string_view::npos)
-      {
-        LOG(warning) << "Cannot find the header separator";
+        LOG(warning) << "Cannot find the boundary or header separator";
         derived().lowestLayer().close();
         failed(source::make_error_code(source::ErrorCode::RESTART_STREAM),
                "Framing error in streaming data: no content length");
         return false;
       }
-      ep += 4;
 
       using string_view_range = boost::iterator_range<boost::string_view::iterator>;
-      auto svi = string_view_range(view.begin() + bp, view.end());
+      auto svi = string_view_range(view.begin() + bp, view.begin() + ep);
       auto lp = boost::ifind_first(svi, boost::string_view("content-length:"));
 
       if (lp.empty())
@@ -438,7 +436,7 @@ namespace mtconnect::source::adapter::agent_adapter {
         return false;
       }
 
-      boost::string_view length(lp.end());
+      boost::string_view length(lp.end(), view.begin() + ep + 2 - lp.end());
       auto digits = length.substr(0, length.find("\n"));
       auto finder = boost::token_finder(algo::is_digit(), algo::token_compress_on);
       auto rng = finder(digits.begin(), digits.end());
@@ -451,13 +449,59 @@ namespace mtconnect::source::adapter::agent_adapter {
         return false;
       }
 
-      m_chunkLength = boost::lexical_cast<size_t>(rng);
+      // Lengths that do not fit are as bad as ones that are too large
+      auto size = std::numeric_limits<uintmax_t>::max();
+      try
+      {
+        size = boost::lexical_cast<uintmax_t>(rng);
+      }
+      catch (boost::bad_lexical_cast &)
+      {}
+
+      if (size > m_maxPartSize)
+      {
+        LOG(warning) << "Part content length " << size << " exceeds the maximum part size of "
+                     << m_maxPartSize;
+        derived().lowestLayer().close();
+        failed(source::make_error_code(source::ErrorCode::RESTART_STREAM),
+               "Framing error in streaming data: content length too large");
+        return false;
+      }
+
+      m_chunkLength = size_t(size);
       m_hasHeader = true;
-      m_chunk.consume(ep);
+      m_header.erase(0, ep + 4);
+
+      // The part is moved into the pipeline when complete, so allocate exactly what is needed
+      m_part.clear();
+      m_part.reserve(m_chunkLength);
 
       return true;
     }
 
+    // Appends as much of data as the current part needs and delivers the part when it is
+    // complete. Returns the number of bytes used.
+    size_t appendPart(std::string_view data)
+    {
+      auto used = std::min(data.size(), m_chunkLength - m_part.size());
+      m_part.append(data.data(), used);
+
+      if (m_part.size() == m_chunkLength)
+      {
+        LOG(trace) << "Received Chunk: --------\n" << m_part << "\n-------------";
+
+        m_hasHeader = false;
+        processData(std::move(m_part));
+        m_part.clear();
+
+        // The stream continues as long as next returns true after each part
+        if (m_request && m_request->m_next && !m_request->m_next())
+          m_endStream = true;
+      }
+
+      return used;
+    }
+
     void createChunkBodyHandler()
     {
       m_chunkHandler = [this](std::uint64_t remain, boost::string_view body,
@@ -470,43 +514,60 @@ namespace mtconnect::source::adapter::agent_adapter {
           return body.size();
         }
 
-        {
-          std::ostream cstr(&m_chunk);
-          cstr << body;
-        }
-
-        LOG(trace) << "Received: -------- " << m_chunk.size() << " " << remain << "\n"
+        LOG(trace) << "Received: -------- " << body.size() << " " << remain << "\n"
                    << body << "\n-------------";
 
-        if (!m_hasHeader)
+        // Part bodies are copied once from the read buffer into their own string. Only the
+        // multipart headers between them are accumulated in m_header, which is reused.
+        std::string_view data(body.data(), body.size());
+        while (m_request && !m_endStream)
         {
-          if (!parseMimeHeader())
+          if (m_hasHeader)
           {
-            LOG(trace) << "Insufficient data to parse chunk header, wait for more data";
-            return body.size();
+            if (data.empty())
+              break;
+            data.remove_prefix(appendPart(data));
           }
-        }
-
-        auto len = m_chunk.size();
-        if (len >= m_chunkLength)
-        {
-          auto start = static_cast<const char *>(m_chunk.data().data());
-          string_view sbuf(start, m_chunkLength);
-
-          LOG(trace) << "Received Chunk: --------\n" << sbuf << "\n-------------";
+          else
+          {
+            m_header.append(data.data(), data.size());
+            data = std::string_view();
 
-          processData(string(sbuf));
+            if (!parseMimeHeader())
+            {
+              LOG(trace) << "Insufficient data to parse chunk header, wait for more data";
+              break;
+            }
 
-          m_chunk.consume(m_chunkLength);
-          m_hasHeader = false;
+            // Anything after the header is the start of the part
+            m_header.erase(0, appendPart(m_header));
+          }
         }
 
+        // Stop reading, onRead ends the stream
+        if (m_endStream)
+          ev = asio::error::operation_aborted;
+
         return body.size();
       };
 
       m_chunkParser->on_chunk_body(m_chunkHandler);
     }
 
+    // Closes the connection of a stream ended by its next and makes the next queued request
+    void endStream()
+    {
+      derived().lowestLayer().close();
+      m_request.reset();
+
+      if (!m_queue.empty())
+      {
+        Request req = m_queue.front();
+        m_queue.pop_front();
+        makeRequest(req);
+      }
+    }
+
     void onChunkedContent()
     {
       m_boundary = findBoundary();
@@ -553,13 +614,15 @@ namespace mtconnect::source::adapter::agent_adapter {
 
     size_t m_chunkLength;
     bool m_hasHeader = false;
-    boost::asio::streambuf m_chunk;
+    std::string m_header;
+    std::string m_part;
 
     // For request queuing
     std::optional<Request> m_request;
     RequestQueue m_queue;
 
     bool m_closeOnRead = false;
+    bool m_endStream = false;
   };
 
 }  // namespace mtconnect::source::adapter::agent_adapter
@@ -0,0 +1,102 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#pragma once
+
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ssl.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace mtconnect::source::adapter::agent_adapter {
+  // The TLS client context shared by all the agent adapters on an io_context. It also keeps
+  // the last session negotiated with each upstream agent so new connections can resume it
+  // with an abbreviated handshake.
+  class SharedTlsContext
+  {
+  public:
+    SharedTlsContext() : m_context(boost::asio::ssl::context::tlsv12_client)
+    {
+      m_context.set_verify_mode(boost::asio::ssl::verify_none);
+      SSL_CTX_set_session_cache_mode(m_context.native_handle(), SSL_SESS_CACHE_CLIENT);
+    }
+
+    // The context for the io_context, created on first use
+    static std::shared_ptr<SharedTlsContext> get(boost::asio::io_context &context)
+    {
+      auto &service = boost::asio::use_service<Service>(context);
+      std::lock_guard<std::mutex> lock(service.m_mutex);
+      if (!service.m_context)
+        service.m_context = std::make_shared<SharedTlsContext>();
+      return service.m_context;
+    }
+
+    boost::asio::ssl::context &context() { return m_context; }
+
+    // Offers the cached session for the upstream before the handshake
+    void resume(SSL *ssl, const std::string &upstream)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto session = m_sessions.find(upstream);
+      if (session != m_sessions.end())
+        SSL_set_session(ssl, session->second.get());
+    }
+
+    // Keeps a copy of the session negotiated by a successful handshake. OpenSSL marks the
+    // connection's own session as not resumable when it is closed without a close_notify,
+    // which is how streams to an upstream agent usually end.
+    void save(SSL *ssl, const std::string &upstream)
+    {
+      auto negotiated = SSL_get0_session(ssl);
+      if (!negotiated)
+        return;
+
+      std::shared_ptr<SSL_SESSION> session(SSL_SESSION_dup(negotiated), SSL_SESSION_free);
+      if (session)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sessions.insert_or_assign(upstream, std::move(session));
+      }
+    }
+
+  protected:
+    struct Service : public boost::asio::execution_context::service
+    {
+      using key_type = Service;
+      static inline boost::asio::execution_context::id id;
+
+      explicit Service(boost::asio::execution_context &context)
+        : boost::asio::execution_context::service(context)
+      {}
+      void shutdown() override
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_context.reset();
+      }
+
+      std::mutex m_mutex;
+      std::shared_ptr<SharedTlsContext> m_context;
+    };
+
+    boost::asio::ssl::context m_context;
+    std::mutex m_mutex;
+    std::map<std::string, std::shared_ptr<SSL_SESSION>> m_sessions;
+  };
+}  // namespace mtconnect::source::adapter::agent_adapter
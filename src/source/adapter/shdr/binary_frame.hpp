@@ -0,0 +1,214 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace mtconnect::source::adapter::shdr {
+  // Framed binary variant of the SHDR protocol for high rate adapters. The adapter sends
+  // "* protocol: binary" and switches to frames once the agent echoes the command back.
+  //
+  // Every frame is a one byte type followed by a four byte payload length and the payload:
+  //   D  define  uint16 index, the data item key as in SHDR (device:name or name)
+  //   S  sample  int64 timestamp, uint16 index, double value
+  //   V  vector  int64 timestamp, uint16 index, double sample rate, double values...
+  //   T  text    an SHDR line, for other observations and protocol commands
+  //
+  // All numbers are little endian. Timestamps are microseconds since the UNIX epoch in UTC,
+  // 0 uses the agent's time. A NaN value makes the observation UNAVAILABLE. A text frame with
+  // "* protocol: text" returns the connection to text lines.
+  struct BinaryFrame
+  {
+    enum Type : char
+    {
+      DEFINE = 'D',
+      SAMPLE = 'S',
+      VECTOR = 'V',
+      TEXT = 'T'
+    };
+
+    // Frames must fit in the connector's incoming buffer
+    static constexpr size_t HeaderSize = 5;
+    static constexpr size_t MaxPayload = 1024 * 1024 - HeaderSize;
+
+    Type m_type {TEXT};
+    uint16_t m_index {0};
+    int64_t m_timestamp {0};
+    double m_value {0.0};
+    double m_sampleRate {0.0};
+    // Key of a define frame, line of a text frame or the raw values of a vector frame.
+    // A view of the connector's buffer and only valid while the frame is processed.
+    std::string_view m_data;
+
+    size_t valueCount() const { return m_type == VECTOR ? m_data.size() / sizeof(double) : 0; }
+    void values(std::vector<double> &out) const;
+
+    // Decode the frame at the beginning of the data. Returns the size of the frame or 0 if
+    // the frame is not complete. Throws std::runtime_error if the frame is malformed.
+    static size_t decode(const char *data, size_t size, BinaryFrame &frame);
+
+    // Encoders for adapters and tests
+    static void encodeDefine(std::string &out, uint16_t index, const std::string_view &key);
+    static void encodeSample(std::string &out, int64_t timestamp, uint16_t index, double value);
+    static void encodeVector(std::string &out, int64_t timestamp, uint16_t index,
+                             double sampleRate, const std::vector<double> &values);
+    static void encodeText(std::string &out, const std::string_view &line);
+  };
+
+  namespace binary {
+    template <typename T>
+    inline T read(const char *data)
+    {
+      uint64_t v = 0;
+      for (size_t i = 0; i < sizeof(T); i++)
+        v |= uint64_t(uint8_t(data[i])) << (8 * i);
+      if constexpr (std::is_same_v<T, double>)
+      {
+        double d;
+        std::memcpy(&d, &v, sizeof(d));
+        return d;
+      }
+      else
+        return T(v);
+    }
+
+    template <typename T>
+    inline void write(std::string &out, T value)
+    {
+      uint64_t v;
+      if constexpr (std::is_same_v<T, double>)
+        std::memcpy(&v, &value, sizeof(v));
+      else
+        v = uint64_t(value);
+      for (size_t i = 0; i < sizeof(T); i++)
+        out.push_back(char((v >> (8 * i)) & 0xFF));
+    }
+
+    inline void header(std::string &out, BinaryFrame::Type type, size_t payload)
+    {
+      out.push_back(char(type));
+      write<uint32_t>(out, uint32_t(payload));
+    }
+  }  // namespace binary
+
+  inline void BinaryFrame::values(std::vector<double> &out) const
+  {
+    auto count = valueCount();
+    out.reserve(out.size() + count);
+    for (size_t i = 0; i < count; i++)
+      out.push_back(binary::read<double>(m_data.data() + i * sizeof(double)));
+  }
+
+  inline size_t BinaryFrame::decode(const char *data, size_t size, BinaryFrame &frame)
+  {
+    using namespace binary;
+
+    if (size < HeaderSize)
+      return 0;
+
+    auto length = read<uint32_t>(data + 1);
+    if (length > MaxPayload)
+      throw std::runtime_error("binary frame payload of " + std::to_string(length) +
+                               " bytes is too large");
+    if (size < HeaderSize + length)
+      return 0;
+
+    auto payload = data + HeaderSize;
+    auto expect = [length](size_t min, bool exact) {
+      if (length < min || (exact && length != min))
+        throw std::runtime_error("binary frame has the wrong size: " + std::to_string(length));
+    };
+
+    frame.m_type = Type(data[0]);
+    switch (frame.m_type)
+    {
+      case DEFINE:
+        expect(3, false);
+        frame.m_index = read<uint16_t>(payload);
+        frame.m_data = std::string_view(payload + 2, length - 2);
+        break;
+
+      case SAMPLE:
+        expect(18, true);
+        frame.m_timestamp = read<int64_t>(payload);
+        frame.m_index = read<uint16_t>(payload + 8);
+        frame.m_value = read<double>(payload + 10);
+        frame.m_data = std::string_view();
+        break;
+
+      case VECTOR:
+        expect(18, false);
+        if ((length - 18) % sizeof(double) != 0)
+          throw std::runtime_error("binary vector frame has a partial value");
+        frame.m_timestamp = read<int64_t>(payload);
+        frame.m_index = read<uint16_t>(payload + 8);
+        frame.m_sampleRate = read<double>(payload + 10);
+        frame.m_data = std::string_view(payload + 18, length - 18);
+        break;
+
+      case TEXT:
+        frame.m_data = std::string_view(payload, length);
+        break;
+
+      default:
+        throw std::runtime_error("unknown binary frame type: " + std::to_string(int(data[0])));
+    }
+
+    return HeaderSize + length;
+  }
+
+  inline void BinaryFrame::encodeDefine(std::string &out, uint16_t index,
+                                        const std::string_view &key)
+  {
+    binary::header(out, DEFINE, 2 + key.size());
+    binary::write(out, index);
+    out.append(key);
+  }
+
+  inline void BinaryFrame::encodeSample(std::string &out, int64_t timestamp, uint16_t index,
+                                        double value)
+  {
+    binary::header(out, SAMPLE, 18);
+    binary::write(out, timestamp);
+    binary::write(out, index);
+    binary::write(out, value);
+  }
+
+  inline void BinaryFrame::encodeVector(std::string &out, int64_t timestamp, uint16_t index,
+                                        double sampleRate, const std::vector<double> &values)
+  {
+    binary::header(out, VECTOR, 18 + values.size() * sizeof(double));
+    binary::write(out, timestamp);
+    binary::write(out, index);
+    binary::write(out, sampleRate);
+    for (auto v : values)
+      binary::write(out, v);
+  }
+
+  inline void BinaryFrame::encodeText(std::string &out, const std::string_view &line)
+  {
+    binary::header(out, TEXT, line.size());
+    out.append(line);
+  }
+}  // namespace mtconnect::source::adapter::shdr
@@ -21,6 +21,7 @@
 #include <boost/asio.hpp>
 #include <boost/asio/bind_executor.hpp>
 #include <boost/asio/connect.hpp>
+#include <boost/asio/read.hpp>
 #include <boost/asio/read_until.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/bind/bind.hpp>
@@ -52,8 +53,8 @@ namespace mtconnect::source::adapter::shdr {
       m_localPort(0),
       m_incoming(1024 * 1024),
       m_timer(strand.context()),
-      m_heartbeatTimer(strand.context()),
-      m_receiveTimeout(strand.context()),
+      m_heartbeatTimer(makeTimer(&Connector::heartbeat)),
+      m_receiveTimeout(makeTimer(&Connector::receiveTimedOut)),
       m_connected(false),
       m_disconnecting(false),
       m_realTime(false),
@@ -64,6 +65,9 @@ namespace mtconnect::source::adapter::shdr {
 
   Connector::~Connector()
   {
+    m_heartbeatTimer->cancel();
+    m_receiveTimeout->cancel();
+
     if (m_socket.is_open())
     {
       m_socket.cancel();
@@ -74,6 +78,22 @@ namespace mtconnect::source::adapter::shdr {
       m_reconnectInterval = 500ms;
   }
 
+  // The wheel calls the handler on one of the context's threads, run it on the strand unless
+  // the timer has been cancelled or armed again in the meantime.
+  TimerWheel::TimerPtr Connector::makeTimer(void (Connector::*handler)())
+  {
+    auto timer = TimerWheel::get(m_strand.context())->makeTimer();
+    std::weak_ptr<TimerWheel::Timer> weak(timer);
+    timer->setHandler([this, strand = m_strand, weak, handler](uint64_t epoch) mutable {
+      asio::post(strand, [this, weak, handler, epoch]() {
+        auto timer = weak.lock();
+        if (timer && timer->isCurrent(epoch))
+          (this->*handler)();
+      });
+    });
+    return timer;
+  }
+
   bool Connector::start() { return resolve(); }
 
   bool Connector::resolve()
@@ -193,6 +213,7 @@ namespace mtconnect::source::adapter::shdr {
 
       connected();
       m_connected = true;
+      setReceiveTimeout();
       sendCommand("PING");
 
       reader(sys::error_code(), 0);
@@ -219,18 +240,14 @@ namespace mtconnect::source::adapter::shdr {
       {
         while (m_connected && m_socket.is_open())
         {
-          m_timer.expires_from_now(m_receiveTimeLimit);
-          m_timer.async_wait(asio::bind_executor(m_strand, [this](boost::system::error_code ec) {
-            if (ec != boost::asio::error::operation_aborted)
-            {
-              LOG(warning) << "operation timed out after " << m_receiveTimeLimit.count() << "ms";
-              reconnect();
-            }
-          }));
-          yield asio::async_read_until(
-              m_socket, m_incoming, '\n',
-              asio::bind_executor(m_strand, boost::bind(&Connector::reader, this, _1, _2)));
-          m_timer.cancel();
+          if (m_binary)
+            yield asio::async_read(
+                m_socket, m_incoming, asio::transfer_at_least(1),
+                asio::bind_executor(m_strand, boost::bind(&Connector::reader, this, _1, _2)));
+          else
+            yield asio::async_read_until(
+                m_socket, m_incoming, '\n',
+                asio::bind_executor(m_strand, boost::bind(&Connector::reader, this, _1, _2)));
           while (parseSocketBuffer())
             ;
         }
@@ -260,25 +277,33 @@ namespace mtconnect::source::adapter::shdr {
       ;
   }
 
+  void Connector::parseBuffer(const char *buffer, size_t length)
+  {
+    std::ostream os(&m_incoming);
+    os.write(buffer, length);
+    while (parseSocketBuffer())
+      ;
+  }
+
   inline void Connector::setReceiveTimeout()
   {
     NAMED_SCOPE("Connector::setReceiveTimeout");
 
-    m_receiveTimeout.expires_from_now(m_receiveTimeLimit);
-    m_receiveTimeout.async_wait(asio::bind_executor(m_strand, [this](sys::error_code ec) {
-      if (!ec)
-      {
-        LOG(error) << "(Port:" << m_localPort << ")"
-                   << " connect: Did not receive data for over: " << m_receiveTimeLimit.count()
-                   << " ms";
-        reconnect();
-      }
-      else if (ec != boost::asio::error::operation_aborted)
-      {
-        LOG(error) << "Receive timeout: " << ec.category().message(ec.value()) << ": "
-                   << ec.message();
-      }
-    }));
+    // Pushing the deadline back is an atomic store, this is called for every read
+    m_receiveTimeout->expiresAfter(m_receiveTimeLimit);
+  }
+
+  void Connector::receiveTimedOut()
+  {
+    NAMED_SCOPE("Connector::receiveTimedOut");
+
+    if (m_connected)
+    {
+      LOG(error) << "(Port:" << m_localPort << ")"
+                 << " connect: Did not receive data for over: " << m_receiveTimeLimit.count()
+                 << " ms";
+      reconnect();
+    }
   }
 
   inline void Connector::processLine(const std::string &line)
@@ -325,44 +350,141 @@ namespace mtconnect::source::adapter::shdr {
     if (m_incoming.size() == 0)
       return false;
 
+    if (m_binary)
+      return parseBinaryBuffer();
+
     // Grab the beginning of the data buffer.
     auto start = static_cast<const char *>(m_incoming.data().data());
     auto len = m_incoming.data().size();
+    auto end = start + len;
 
     LOG(trace) << "(" << m_server << ":" << m_port << ") " << len
                << " characters in incomming buffer";
 
-    // Scan forward in the buffer for a \n
-    const char *eol = static_cast<const char *>(memchr(start, '\n', len));
-    size_t consumed = (eol == nullptr) ? 0 : eol - start + 1;
-
-    // If there is no end of line, wait for more data.
-    if (consumed == 0)
-    {
-      LOG(trace) << "(" << m_server << ":" << m_port
-                 << ") no eol found, waiting for more characters";
-      return false;
-    }
-    else
+    // Take all the complete lines from the buffer. Data lines are passed on as a batch,
+    // protocol commands are handled in order between them.
+    std::list<std::string> lines;
+    auto cp = start;
+    const char *eol;
+    bool switched = false;
+    while (!switched &&
+           cp < end && (eol = static_cast<const char *>(memchr(cp, '\n', end - cp))) != nullptr)
     {
       // Check for the condition when the line is blank
       // This is a manual trim right using char* to skip additional work in string
-      size_t size = (consumed == 1) ? 0 : rightTrimmedSize(eol - 1, start);
+      size_t size = (eol == cp) ? 0 : rightTrimmedSize(eol - 1, cp);
 
       // Check for a blank line, just consume and carry on
       if (size == 0)
       {
         LOG(trace) << "(" << m_server << ":" << m_port << ") blank line after trimming";
       }
+      else if (*cp == '*')
+      {
+        if (!lines.empty())
+        {
+          processLines(lines);
+          lines.clear();
+        }
+        processLine({cp, size});
+
+        // The rest of the buffer is binary frames
+        switched = m_binary;
+      }
       else
       {
-        // We have a line
-        processLine({start, size});
+        LOG(trace) << "(" << m_server << ":" << m_port
+                   << ") Received line: " << std::string_view(cp, size);
+        lines.emplace_back(cp, size);
+      }
+
+      cp = eol + 1;
+    }
+
+    if (!lines.empty())
+      processLines(lines);
+
+    // If there is no end of line, wait for more data.
+    if (cp == start)
+    {
+      LOG(trace) << "(" << m_server << ":" << m_port
+                 << ") no eol found, waiting for more characters";
+      return false;
+    }
+
+    m_incoming.consume(cp - start);
+
+    // All complete lines have been consumed unless the protocol changed
+    return switched;
+  }
+
+  bool Connector::parseBinaryBuffer()
+  {
+    NAMED_SCOPE("Connector::parseBinaryBuffer");
+
+    auto start = static_cast<const char *>(m_incoming.data().data());
+    auto len = m_incoming.data().size();
+
+    LOG(trace) << "(" << m_server << ":" << m_port << ") " << len << " bytes in incomming buffer";
+
+    // Data frames are passed on as a batch, text frames are handled in order between them
+    std::vector<BinaryFrame> frames;
+    size_t pos = 0;
+    bool switched = false;
+    try
+    {
+      BinaryFrame frame;
+      while (!switched && pos < len)
+      {
+        auto size = BinaryFrame::decode(start + pos, len - pos, frame);
+        if (size == 0)
+          break;
+        pos += size;
+
+        if (frame.m_type == BinaryFrame::TEXT)
+        {
+          if (!frames.empty())
+          {
+            processFrames(frames);
+            frames.clear();
+          }
+          if (!frame.m_data.empty())
+            processLine(std::string(frame.m_data));
+
+          // The rest of the buffer is text lines
+          switched = !m_binary;
+        }
+        else
+        {
+          frames.emplace_back(frame);
+        }
       }
     }
+    catch (std::runtime_error &e)
+    {
+      LOG(error) << "(" << m_server << ":" << m_port << ") " << e.what() << ", reconnecting";
+      m_incoming.consume(len);
+      reconnect();
+      return false;
+    }
 
-    m_incoming.consume(consumed);
-    return m_incoming.size() > 0;
+    if (!frames.empty())
+      processFrames(frames);
+
+    m_incoming.consume(pos);
+    return switched;
+  }
+
+  void Connector::processFrames(const std::vector<BinaryFrame> &frames)
+  {
+    LOG(warning) << "(" << m_server << ":" << m_port << ") Ignoring " << frames.size()
+                 << " binary frames";
+  }
+
+  void Connector::processLines(std::list<std::string> &lines)
+  {
+    for (const auto &line : lines)
+      processData(line);
   }
 
   void Connector::sendCommand(const string &command)
@@ -381,21 +503,15 @@ namespace mtconnect::source::adapter::shdr {
     }
   }
 
-  void Connector::heartbeat(boost::system::error_code ec)
+  void Connector::heartbeat()
   {
     NAMED_SCOPE("Connector::heartbeat");
 
-    if (!ec)
+    if (m_connected && m_heartbeats)
     {
       LOG(debug) << "Sending heartbeat";
       sendCommand("PING");
-      m_heartbeatTimer.expires_from_now(m_heartbeatFrequency);
-      m_heartbeatTimer.async_wait(
-          asio::bind_executor(m_strand, boost::bind(&Connector::heartbeat, this, _1)));
-    }
-    else if (ec != boost::asio::error::operation_aborted)
-    {
-      LOG(error) << "heartbeat: " << ec.category().message(ec.value()) << ": " << ec.message();
+      m_heartbeatTimer->expiresAfter(m_heartbeatFrequency);
     }
   }
 
@@ -419,9 +535,7 @@ namespace mtconnect::source::adapter::shdr {
         m_receiveTimeLimit = 2 * m_heartbeatFrequency;
         setReceiveTimeout();
 
-        m_heartbeatTimer.expires_from_now(m_heartbeatFrequency);
-        m_heartbeatTimer.async_wait(
-            asio::bind_executor(m_strand, boost::bind(&Connector::heartbeat, this, _1)));
+        m_heartbeatTimer->expiresAfter(m_heartbeatFrequency);
       }
       else
       {
@@ -441,8 +555,8 @@ namespace mtconnect::source::adapter::shdr {
     NAMED_SCOPE("Connector::close");
     LOG(error) << "Closing " << m_server << ":" << m_port << " (Local Port:" << m_localPort << ")";
 
-    m_heartbeatTimer.cancel();
-    m_receiveTimeout.cancel();
+    m_heartbeatTimer->cancel();
+    m_receiveTimeout->cancel();
     m_timer.cancel();
 
     if (m_connected)
@@ -460,6 +574,12 @@ namespace mtconnect::source::adapter::shdr {
 
       m_connected = false;
       m_heartbeats = false;
+      if (m_binary)
+      {
+        // The next connection starts with text lines
+        m_binary = false;
+        m_incoming.consume(m_incoming.size());
+      }
       disconnected();
     }
     m_disconnecting = false;
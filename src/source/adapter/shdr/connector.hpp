@@ -21,9 +21,13 @@
 
 #include <chrono>
 #include <condition_variable>
+#include <list>
 #include <mutex>
 #include <thread>
+#include <vector>
 
+#include "binary_frame.hpp"
+#include "timer_wheel.hpp"
 #include "utilities.hpp"
 
 #define HEARTBEAT_FREQ 60000
@@ -49,8 +53,20 @@ namespace mtconnect::source::adapter::shdr {
 
     // Abstract method to handle what to do with each line of data from Socket
     virtual void processData(const std::string &data) = 0;
+
+    // Handle all the data lines from a read. Calls processData for each line by default.
+    // The lines may be moved from.
+    virtual void processLines(std::list<std::string> &lines);
     virtual void protocolCommand(const std::string &data) = 0;
 
+    // Handle the data frames from a read when using the binary protocol. Text frames are
+    // handled as lines.
+    virtual void processFrames(const std::vector<BinaryFrame> &frames);
+
+    // Switch between SHDR text lines and binary frames, see BinaryFrame
+    void setBinary(bool binary) { m_binary = binary; }
+    bool isBinary() const { return m_binary; }
+
     // Set Reconnect intervals
     void setReconnectInterval(std::chrono::milliseconds interval)
     {
@@ -72,6 +88,7 @@ namespace mtconnect::source::adapter::shdr {
 
     // Collect data and until it is \n terminated
     void parseBuffer(const char *buffer);
+    void parseBuffer(const char *buffer, size_t length);
 
     // Send a command to the adapter
     void sendCommand(const std::string &command);
@@ -97,10 +114,13 @@ namespace mtconnect::source::adapter::shdr {
     void writer(boost::system::error_code ec, std::size_t length);
     void reader(boost::system::error_code ec, std::size_t length);
     bool parseSocketBuffer();
+    bool parseBinaryBuffer();
     void processLine(const std::string &line);
     void startHeartbeats(const std::string &buf);
-    void heartbeat(boost::system::error_code ec);
+    void heartbeat();
+    void receiveTimedOut();
     void setReceiveTimeout();
+    TimerWheel::TimerPtr makeTimer(void (Connector::*handler)());
 
   protected:
     // Name of the server to connect to
@@ -125,8 +145,10 @@ namespace mtconnect::source::adapter::shdr {
 
     // Some timeers
     boost::asio::steady_timer m_timer;
-    boost::asio::steady_timer m_heartbeatTimer;
-    boost::asio::steady_timer m_receiveTimeout;
+
+    // Heartbeats and receive timeouts are on the io_context's timer wheel
+    TimerWheel::TimerPtr m_heartbeatTimer;
+    TimerWheel::TimerPtr m_receiveTimeout;
 
     // The connected state of this connector
     bool m_connected;
@@ -135,6 +157,9 @@ namespace mtconnect::source::adapter::shdr {
     // Priority boost
     bool m_realTime;
 
+    // Binary frames instead of text lines
+    bool m_binary {false};
+
     // Heartbeats
     bool m_heartbeats = false;
     std::chrono::milliseconds m_heartbeatFrequency = std::chrono::milliseconds {HEARTBEAT_FREQ};
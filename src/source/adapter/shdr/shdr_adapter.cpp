@@ -23,12 +23,14 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <thread>
 #include <utility>
 
 #include "configuration/config_options.hpp"
 #include "device_model/device.hpp"
 #include "logging.hpp"
+#include "observation/observation.hpp"
 
 using namespace std;
 using namespace std::literals;
@@ -146,6 +148,173 @@ namespace mtconnect::source::adapter::shdr {
     }
   }
 
+  void ShdrAdapter::processLines(std::list<std::string> &lines)
+  {
+    NAMED_SCOPE("ShdrAdapter::processLines");
+
+    if (!m_handler || !m_handler->m_processLines)
+    {
+      Connector::processLines(lines);
+      return;
+    }
+
+    // Send consecutive lines through the pipeline as one batch. Multiline bodies are
+    // assembled a line at a time by processData.
+    std::list<std::string> batch;
+    auto flush = [&]() {
+      if (batch.empty())
+        return;
+
+      try
+      {
+        m_handler->m_processLines(batch, getIdentity());
+      }
+      catch (std::exception &e)
+      {
+        LOG(error) << "Error in processLines: " << e.what();
+      }
+      catch (...)
+      {
+        LOG(error) << "Unknown exception in processLines";
+      }
+      batch.clear();
+    };
+
+    for (auto line = lines.begin(); line != lines.end();)
+    {
+      if (m_terminator || line->find("--multiline--") != string::npos)
+      {
+        flush();
+        processData(*line++);
+      }
+      else
+      {
+        batch.splice(batch.end(), lines, line++);
+      }
+    }
+    flush();
+  }
+
+  DataItemPtr ShdrAdapter::frameDataItem(uint16_t index)
+  {
+    auto generation = m_pipeline.getContract()->deviceGeneration();
+    if (!generation || generation != m_frameGeneration)
+    {
+      m_frameDataItems.assign(m_frameKeys.size(), nullptr);
+      m_frameGeneration = generation;
+    }
+
+    if (index >= m_frameKeys.size() || m_frameKeys[index].empty())
+      return nullptr;
+
+    auto &dataItem = m_frameDataItems[index];
+    if (!dataItem)
+    {
+      const auto &key = m_frameKeys[index];
+      auto c = key.find(':');
+      if (c != string::npos)
+        dataItem = m_pipeline.getContract()->findDataItem(key.substr(0, c), key.substr(c + 1));
+      else
+        dataItem = m_pipeline.getContract()->findDataItem(
+            GetOption<string>(m_options, configuration::Device).value_or(""), key);
+    }
+
+    return dataItem;
+  }
+
+  void ShdrAdapter::processFrames(const std::vector<BinaryFrame> &frames)
+  {
+    NAMED_SCOPE("ShdrAdapter::processFrames");
+
+    using namespace observation;
+
+    if (!m_handler || !m_handler->m_processObservations || !m_pipeline.hasContract())
+      return;
+
+    entity::EntityList observations;
+    auto now = std::chrono::system_clock::now();
+    for (const auto &frame : frames)
+    {
+      if (frame.m_type == BinaryFrame::DEFINE)
+      {
+        if (frame.m_index >= m_frameKeys.size())
+        {
+          m_frameKeys.resize(frame.m_index + 1);
+          m_frameDataItems.resize(frame.m_index + 1);
+        }
+        m_frameKeys[frame.m_index] = string(frame.m_data);
+        m_frameDataItems[frame.m_index].reset();
+        if (!frameDataItem(frame.m_index))
+          LOG(info) << "Could not find data item: " << frame.m_data << " for binary index "
+                    << frame.m_index;
+        continue;
+      }
+
+      auto dataItem = frameDataItem(frame.m_index);
+      if (!dataItem)
+      {
+        LOG(trace) << "No data item for binary index " << frame.m_index;
+        continue;
+      }
+
+      // Frames carry the values directly, no tokens or timestamps to parse
+      entity::Properties props;
+      if (frame.m_type == BinaryFrame::SAMPLE)
+      {
+        if (!std::isnan(frame.m_value))
+          props.insert_or_assign("VALUE", frame.m_value);
+      }
+      else
+      {
+        entity::Vector values;
+        frame.values(values);
+        if (!values.empty())
+        {
+          if (dataItem->isTimeSeries())
+          {
+            props.insert_or_assign("sampleCount", int64_t(values.size()));
+            props.insert_or_assign("sampleRate", frame.m_sampleRate);
+          }
+          props.insert_or_assign("VALUE", std::move(values));
+        }
+      }
+
+      Timestamp timestamp = now;
+      if (frame.m_timestamp != 0)
+        timestamp = m_pipeline.frameTimestamp(Timestamp(Microseconds(frame.m_timestamp)));
+
+      entity::ErrorList errors;
+      auto obs = Observation::make(dataItem, props, timestamp, errors);
+      if (!errors.empty())
+      {
+        for (auto &e : errors)
+          LOG(warning) << "Error creating observation for " << dataItem->getId() << ": "
+                       << e->what();
+      }
+      if (obs && !dataItem->getConstantValue())
+      {
+        dataItem->setDataSource(getIdentity());
+        observations.emplace_back(obs);
+      }
+    }
+
+    if (observations.empty())
+      return;
+
+    try
+    {
+      m_handler->m_processObservations(observations, getIdentity());
+    }
+    catch (std::exception &e)
+    {
+      LOG(error) << "Error in processFrames: " << e.what();
+    }
+    catch (...)
+    {
+      LOG(error) << "Unknown exception in processFrames";
+    }
+  }
+
   void ShdrAdapter::stop()
   {
     NAMED_SCOPE("ShdrAdapter::stop");
@@ -176,6 +345,19 @@ namespace mtconnect::source::adapter::shdr {
 
       ConfigOptions options;
 
+      if (command == "protocol")
+      {
+        // Acknowledge the binary protocol before switching so the adapter knows it is
+        // supported. Older agents ignore the command and the adapter stays with text.
+        auto binary = to_lower_copy(value) == "binary";
+        if (binary != isBinary())
+        {
+          sendCommand(binary ? "protocol: binary" : "protocol: text");
+          setBinary(binary);
+        }
+        return;
+      }
+
       if (command == "conversionrequired")
         options[configuration::ConversionRequired] = is_true(value);
       else if (command == "relativetime")
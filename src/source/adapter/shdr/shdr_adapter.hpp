@@ -24,6 +24,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "connector.hpp"
 #include "device_model/data_item/data_item.hpp"
@@ -66,6 +67,8 @@ namespace mtconnect {
 
       // Inherited method to incoming data from the server
       void processData(const std::string &data) override;
+      void processLines(std::list<std::string> &lines) override;
+      void processFrames(const std::vector<BinaryFrame> &frames) override;
       void protocolCommand(const std::string &data) override;
 
       // Method called when connection is lost.
@@ -112,6 +115,10 @@ namespace mtconnect {
           m_pipeline.start();
       }
 
+    protected:
+      // Resolve the data item for the index of a binary frame
+      DataItemPtr frameDataItem(uint16_t index);
+
     protected:
       ShdrPipeline m_pipeline;
 
@@ -120,6 +127,11 @@ namespace mtconnect {
 
       std::optional<std::string> m_terminator;
       std::stringstream m_body;
+
+      // Data item keys from binary define frames and the data items they resolve to
+      std::vector<std::string> m_frameKeys;
+      std::vector<DataItemPtr> m_frameDataItems;
+      std::optional<uint64_t> m_frameGeneration;
     };
   }  // namespace source::adapter::shdr
 }  // namespace mtconnect
@@ -50,14 +50,13 @@ namespace mtconnect {
       TransformPtr next = bind(make_shared<ShdrTokenizer>());
 
       // Optional type based transforms
+      // Binary frames share the timestamp transform so relative time has one base
       if (IsOptionSet(m_options, configuration::IgnoreTimestamps))
-        next = next->bind(make_shared<IgnoreTimestamp>());
+        m_timestamps = make_shared<IgnoreTimestamp>();
       else
-      {
-        auto extract =
+        m_timestamps =
             make_shared<ExtractTimestamp>(IsOptionSet(m_options, configuration::RelativeTime));
-        next = next->bind(extract);
-      }
+      next = next->bind(m_timestamps);
 
       // Token mapping to data items and asset
       auto mapper = make_shared<ShdrTokenMapper>(
@@ -70,7 +69,11 @@ namespace mtconnect {
       next = next->bind(mapper);
 
       // Handle the observations and send to nowhere
-      buildObservationDelivery(next);
+      auto delivery = buildObservationDelivery(next);
+
+      // Observations from binary frames are already mapped and go straight to delivery
+      bind(make_shared<NullTransform>(TypeGuard<Observation>(SKIP)))->bind(delivery);
+
       applySplices();
     }
   }  // namespace source::adapter::shdr
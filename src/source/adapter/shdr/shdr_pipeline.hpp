@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "pipeline/timestamp_extractor.hpp"
 #include "source/adapter/adapter_pipeline.hpp"
 
 namespace mtconnect::source::adapter::shdr {
@@ -28,5 +29,14 @@ namespace mtconnect::source::adapter::shdr {
     {}
 
     void build(const ConfigOptions &options) override;
+
+    // Applies the IgnoreTimestamps and RelativeTime options to the timestamp of a binary frame
+    Timestamp frameTimestamp(const Timestamp &ts)
+    {
+      return m_timestamps ? m_timestamps->adjustTimestamp(ts) : ts;
+    }
+
+  protected:
+    std::shared_ptr<pipeline::ExtractTimestamp> m_timestamps;
   };
 }  // namespace mtconnect::source::adapter::shdr
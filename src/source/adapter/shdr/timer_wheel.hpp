@@ -0,0 +1,285 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#pragma once
+
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace mtconnect::source::adapter::shdr {
+  // Receive timeouts and heartbeats for all the connectors on an io_context. The timers
+  // share one steady_timer that waits for the next occupied slot of a hashed wheel, and only
+  // while timers are armed. Setting a later deadline is an atomic store, the wheel moves the
+  // timer forward when its slot comes around. A connector can push its receive deadline back
+  // on every read without any timer operations.
+  class TimerWheel : public std::enable_shared_from_this<TimerWheel>
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+    // Called with the timer's epoch when it fired, see Timer::isCurrent
+    using Callback = std::function<void(uint64_t)>;
+    static constexpr int64_t Disarmed = std::numeric_limits<int64_t>::max();
+    static constexpr size_t Slots = 512;
+
+    class Timer : public std::enable_shared_from_this<Timer>
+    {
+    public:
+      Timer(std::shared_ptr<TimerWheel> wheel) : m_wheel(std::move(wheel)) {}
+      ~Timer()
+      {
+        if (m_scheduled.load() != Disarmed)
+          m_wheel->release();
+      }
+
+      // Called from the wheel's thread when the deadline has passed
+      void setHandler(Callback handler) { m_handler = std::move(handler); }
+
+      void expiresAfter(Clock::duration after) { expiresAt(Clock::now() + after); }
+      void expiresAt(Clock::time_point at)
+      {
+        auto tick = m_wheel->tickOf(at);
+        m_deadline.store(tick);
+        auto scheduled = m_scheduled.load();
+        if (scheduled == Disarmed || tick < scheduled)
+          m_wheel->schedule(shared_from_this(), tick);
+      }
+      // Advancing the epoch marks handlers the wheel has already collected as stale
+      void cancel()
+      {
+        m_deadline.store(Disarmed);
+        m_epoch.fetch_add(1);
+      }
+      bool isArmed() const { return m_deadline.load() != Disarmed; }
+      // A firing is current if the timer was neither cancelled nor armed again since
+      bool isCurrent(uint64_t epoch) const { return epoch == m_epoch.load() && !isArmed(); }
+
+    protected:
+      friend class TimerWheel;
+
+      std::shared_ptr<TimerWheel> m_wheel;
+      Callback m_handler;
+      std::atomic<int64_t> m_deadline {Disarmed};
+      std::atomic<uint64_t> m_epoch {0};
+      // The tick of the slot holding the timer, set under the wheel's mutex
+      std::atomic<int64_t> m_scheduled {Disarmed};
+      uint64_t m_version {0};
+    };
+    using TimerPtr = std::shared_ptr<Timer>;
+
+    TimerWheel(boost::asio::io_context &context,
+               Clock::duration tick = std::chrono::milliseconds {50})
+      : m_tick(tick), m_slots(Slots)
+    {
+      m_timer.emplace(context);
+    }
+
+    // The wheel for the io_context, created on first use
+    static std::shared_ptr<TimerWheel> get(boost::asio::io_context &context)
+    {
+      auto &service = boost::asio::use_service<Service>(context);
+      std::lock_guard<std::mutex> lock(service.m_mutex);
+      if (!service.m_wheel)
+        service.m_wheel = std::make_shared<TimerWheel>(context);
+      return service.m_wheel;
+    }
+
+    TimerPtr makeTimer(Callback handler = nullptr)
+    {
+      auto timer = std::make_shared<Timer>(shared_from_this());
+      timer->setHandler(std::move(handler));
+      return timer;
+    }
+
+    Clock::duration getTick() const { return m_tick; }
+
+    // Deadlines are rounded up to the next tick
+    int64_t tickOf(Clock::time_point at) const
+    {
+      auto since = at.time_since_epoch();
+      return (since + m_tick - Clock::duration(1)) / m_tick;
+    }
+
+    // Timers can outlive the io_context, so the steady_timer is released when it shuts down
+    void stop()
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_timer.reset();
+      m_running = false;
+      for (auto &slot : m_slots)
+        slot.clear();
+      m_live = 0;
+    }
+
+  protected:
+    struct Entry
+    {
+      std::weak_ptr<Timer> m_timer;
+      uint64_t m_version;
+    };
+
+    struct Service : public boost::asio::execution_context::service
+    {
+      using key_type = Service;
+      static inline boost::asio::execution_context::id id;
+
+      explicit Service(boost::asio::execution_context &context)
+        : boost::asio::execution_context::service(context)
+      {}
+      void shutdown() override
+      {
+        std::shared_ptr<TimerWheel> wheel;
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          wheel.swap(m_wheel);
+        }
+        if (wheel)
+          wheel->stop();
+      }
+
+      std::mutex m_mutex;
+      std::shared_ptr<TimerWheel> m_wheel;
+    };
+
+    void schedule(const TimerPtr &timer, int64_t tick)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto scheduled = timer->m_scheduled.load();
+      if (scheduled != Disarmed && scheduled <= tick)
+        return;
+
+      if (!m_running)
+        m_current = Clock::now().time_since_epoch() / m_tick;
+      tick = std::max(tick, m_current + 1);
+      insert(timer, tick);
+      if (m_timer && (!m_running || tick < m_next))
+      {
+        m_running = true;
+        wait(tick);
+      }
+    }
+
+    // Called with the mutex held. The tick must be after the last processed tick.
+    void insert(const TimerPtr &timer, int64_t tick)
+    {
+      if (timer->m_scheduled.exchange(tick) == Disarmed)
+        m_live++;
+      m_slots[tick % Slots].push_back({timer, ++timer->m_version});
+    }
+
+    // A scheduled timer was destroyed
+    void release()
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_live > 0)
+        m_live--;
+    }
+
+    // Called with the mutex held. Replaces the current wait if there is one.
+    void wait(int64_t tick)
+    {
+      m_next = tick;
+      m_timer->expires_at(Clock::time_point(m_tick * tick));
+      m_timer->async_wait([self = shared_from_this()](boost::system::error_code ec) {
+        if (!ec)
+          self->tick();
+      });
+    }
+
+    void tick()
+    {
+      std::vector<std::pair<TimerPtr, uint64_t>> expired;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running)
+          return;
+
+        int64_t now = Clock::now().time_since_epoch() / m_tick;
+        auto last = std::min(now, m_current + int64_t(Slots));
+        std::vector<Entry> entries;
+        for (auto t = m_current + 1; t <= last; t++)
+        {
+          auto &slot = m_slots[t % Slots];
+          if (slot.empty())
+            continue;
+
+          entries.clear();
+          entries.swap(slot);
+          for (auto &e : entries)
+          {
+            // Skip timers that are gone or were moved to another slot
+            auto timer = e.m_timer.lock();
+            if (!timer || e.m_version != timer->m_version)
+              continue;
+
+            // Clear the slot before taking the deadline so a concurrent expiresAt either
+            // changes the deadline first or sees the timer needs scheduling.
+            timer->m_scheduled.store(Disarmed);
+            m_live--;
+            // cancel disarms before advancing the epoch, so an epoch read before the exchange
+            // is either the one the timer fired in or the exchange fails
+            auto epoch = timer->m_epoch.load();
+            auto deadline = timer->m_deadline.load();
+            if (deadline != Disarmed && deadline <= now &&
+                timer->m_deadline.compare_exchange_strong(deadline, Disarmed))
+              expired.emplace_back(timer, epoch);
+            else if (deadline != Disarmed)
+              insert(timer, std::max(deadline, now + 1));
+          }
+        }
+        m_current = now;
+
+        // Stale entries are left in their slots when there are no timers to wait for
+        if (m_live > 0)
+        {
+          auto next = m_current + 1;
+          while (next < m_current + int64_t(Slots) && m_slots[next % Slots].empty())
+            next++;
+          wait(next);
+        }
+        else
+          m_running = false;
+      }
+
+      for (auto &[timer, epoch] : expired)
+        if (timer->m_handler)
+          timer->m_handler(epoch);
+    }
+
+  protected:
+    Clock::duration m_tick;
+    std::optional<boost::asio::steady_timer> m_timer;
+
+    std::mutex m_mutex;
+    std::vector<std::vector<Entry>> m_slots;
+    int64_t m_current {0};
+    int64_t m_next {0};
+    size_t m_live {0};
+    bool m_running {false};
+  };
+}  // namespace mtconnect::source::adapter::shdr
@@ -31,7 +31,11 @@
 #define NOMINMAX 1
 #endif
 
+#include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <cctype>
+#include <cstdio>
 #include <ctime>
 #include <date/date.h>
 #include <fstream>
@@ -43,9 +47,11 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <time.h>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 #if defined(_WIN32) || defined(_WIN64)
 #ifndef _WINDOWS
@@ -138,13 +144,28 @@ namespace mtconnect {
     return value;
   }
 
+  // Append a double with digits10 significant digits, the same as formatted(v) on a stream,
+  // without the overhead of a stream.
+  inline void appendDouble(std::string &out, double value)
+  {
+    constexpr int precision = std::numeric_limits<double>::digits10;
+    char buffer[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto res = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general,
+                             precision);
+    out.append(buffer, res.ptr);
+#else
+    auto len = snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+    out.append(buffer, len);
+#endif
+  }
+
   // Convert a float to string
   inline std::string format(double value)
   {
-    std::stringstream s;
-    constexpr int precision = std::numeric_limits<double>::digits10;
-    s << std::setprecision(precision) << value;
-    return s.str();
+    std::string s;
+    appendDouble(s, value);
+    return s;
   }
 
   class format_double_stream
@@ -203,24 +224,174 @@ namespace mtconnect {
     return true;
   }
 
+  // Parse the entire text as a double. Returns nullopt if the text is not a plain number
+  // or has trailing characters so the caller can fall back to the lenient strtod
+  // conversion used by the entity requirements.
+  inline std::optional<double> parseDouble(const std::string_view &text)
+  {
+    double value;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto res = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (res.ec != std::errc() || res.ptr != text.data() + text.size())
+      return std::nullopt;
+#else
+    // Floating point from_chars is not available with all standard libraries
+    char buffer[64];
+    if (text.empty() || text.size() >= sizeof(buffer) || std::isspace(text.front()))
+      return std::nullopt;
+    *std::copy(text.begin(), text.end(), buffer) = '\0';
+    char *ep = nullptr;
+    value = strtod(buffer, &ep);
+    if (ep != buffer + text.size())
+      return std::nullopt;
+#endif
+    return value;
+  }
+
+  // Parse the entire text as a base 10 integer, see parseDouble
+  inline std::optional<int64_t> parseInteger(const std::string_view &text)
+  {
+    int64_t value;
+    auto res = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (res.ec != std::errc() || res.ptr != text.data() + text.size())
+      return std::nullopt;
+    return value;
+  }
+
+  // Parse white space separated doubles from the text into out. Returns false if any value
+  // is not a plain number so the caller can fall back to the lenient conversion. Parses the
+  // view in place without copying it.
+  inline bool parseVector(const std::string_view &text, std::vector<double> &out)
+  {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto start = out.size();
+    out.reserve(start + std::count(text.begin(), text.end(), ' ') + 1);
+
+    auto cp = text.data(), end = text.data() + text.size();
+    while (cp < end)
+    {
+      if (std::isspace(static_cast<unsigned char>(*cp)))
+      {
+        cp++;
+        continue;
+      }
+
+      double value;
+      auto res = std::from_chars(cp, end, value);
+      if (res.ec != std::errc() ||
+          (res.ptr < end && !std::isspace(static_cast<unsigned char>(*res.ptr))))
+      {
+        out.resize(start);
+        return false;
+      }
+      out.push_back(value);
+      cp = res.ptr;
+    }
+
+    return out.size() > start;
+#else
+    return false;
+#endif
+  }
+
   void mt_localtime(const time_t *time, struct tm *buf);
 
+  // Formats the "YYYY-MM-DDTHH:MM:SS" prefix of a time point at out and returns the end. The
+  // prefix is 19 characters for years 0000-9999 and at most 21 otherwise.
+  // Consecutive timestamps usually fall in the same second, so the last prefix is cached
+  // per thread and only the fraction needs to be formatted by the caller. Years outside
+  // 0000-9999 fall back to date::format.
+  inline char *formatSecondPrefix(const std::chrono::time_point<std::chrono::system_clock,
+                                                                std::chrono::seconds> &secs,
+                                  char *out)
+  {
+    using namespace std::chrono;
+
+    struct PrefixCache
+    {
+      char m_text[19];
+      std::chrono::seconds m_seconds;
+      bool m_valid {false};
+    };
+    static thread_local PrefixCache cache;
+
+    if (!cache.m_valid || cache.m_seconds != secs.time_since_epoch())
+    {
+      auto days = date::floor<date::days>(secs);
+      date::year_month_day ymd(days);
+      int year = int(ymd.year());
+      if (year < 0 || year > 9999)
+      {
+        auto text = date::format("%FT%T", secs);
+        return std::copy(text.begin(), text.end(), out);
+      }
+
+      date::hh_mm_ss<seconds> hms(secs - days);
+      auto two = [](char *p, unsigned v) {
+        p[0] = char('0' + v / 10);
+        p[1] = char('0' + v % 10);
+      };
+      auto *p = cache.m_text;
+      two(p, unsigned(year / 100));
+      two(p + 2, unsigned(year % 100));
+      p[4] = '-';
+      two(p + 5, unsigned(ymd.month()));
+      p[7] = '-';
+      two(p + 8, unsigned(ymd.day()));
+      p[10] = 'T';
+      two(p + 11, unsigned(hms.hours().count()));
+      p[13] = ':';
+      two(p + 14, unsigned(hms.minutes().count()));
+      p[16] = ':';
+      two(p + 17, unsigned(hms.seconds().count()));
+
+      cache.m_seconds = secs.time_since_epoch();
+      cache.m_valid = true;
+    }
+
+    return std::copy_n(cache.m_text, 19, out);
+  }
+
+  // Formats the fraction of a second as '.' followed by six digits of microseconds
+  inline char *formatMicroseconds(unsigned micros, char *out)
+  {
+    *out++ = '.';
+    for (int i = 5; i >= 0; i--)
+    {
+      out[i] = char('0' + micros % 10);
+      micros /= 10;
+    }
+    return out + 6;
+  }
+
   // Get a specified time formatted
   inline std::string getCurrentTime(std::chrono::time_point<std::chrono::system_clock> timePoint,
                                     TimeFormat format)
   {
     using namespace std;
     using namespace std::chrono;
-    constexpr char ISO_8601_FMT[] = "%Y-%m-%dT%H:%M:%SZ";
 
     switch (format)
     {
       case HUM_READ:
         return date::format("%a, %d %b %Y %H:%M:%S GMT", date::floor<seconds>(timePoint));
       case GMT:
-        return date::format(ISO_8601_FMT, date::floor<seconds>(timePoint));
+      {
+        char buffer[32];
+        auto end = formatSecondPrefix(date::floor<seconds>(timePoint), buffer);
+        *end++ = 'Z';
+        return string(buffer, end);
+      }
       case GMT_UV_SEC:
-        return date::format(ISO_8601_FMT, date::floor<microseconds>(timePoint));
+      {
+        char buffer[32];
+        auto secs = date::floor<seconds>(timePoint);
+        auto micros = date::floor<microseconds>(timePoint) - secs;
+        auto end = formatSecondPrefix(secs, buffer);
+        end = formatMicroseconds(unsigned(micros.count()), end);
+        *end++ = 'Z';
+        return string(buffer, end);
+      }
       case LOCAL:
         auto time = system_clock::to_time_t(timePoint);
         struct tm timeinfo = {0};
@@ -504,19 +675,127 @@ namespace mtconnect {
     AddOptions(tree, options, entries);
   }
 
+  // Format a timestamp as YYYY-MM-DDTHH:MM:SS[.ffffff]Z with trailing zeros of the fraction
+  // removed. The prefix for the second is cached per thread, see formatSecondPrefix.
   inline std::string format(const Timestamp &ts)
   {
-    using namespace std;
-    string time = date::format("%FT%T", date::floor<Microseconds>(ts));
-    auto pos = time.find_last_not_of("0");
-    if (pos != string::npos)
+    using namespace std::chrono;
+
+    char buffer[32];
+    auto secs = date::floor<seconds>(ts);
+    auto micros = date::floor<Microseconds>(ts) - secs;
+    auto end = formatSecondPrefix(secs, buffer);
+    if (micros.count() != 0)
+    {
+      end = formatMicroseconds(unsigned(micros.count()), end);
+      while (*(end - 1) == '0')
+        end--;
+    }
+    *end++ = 'Z';
+    return std::string(buffer, end);
+  }
+
+  // Parse an ISO 8601 timestamp of the form YYYY-MM-DD[THH:MM:SS[.fff...][Z|+HH:MM|-HH:MM]].
+  // Fractional digits beyond the clock precision are ignored, as are any characters after
+  // the time zone. Offsets are converted to UTC. Returns nullopt if the text does not
+  // start with a valid date, or a valid date and time when there is a 'T'.
+  //
+  // Consecutive timestamps usually share the date, so the last date is cached per thread.
+  inline std::optional<Timestamp> parseTimestamp(const std::string_view &text)
+  {
+    using namespace std::chrono;
+
+    auto digits = [&text](size_t pos, size_t count, int &value) {
+      if (pos + count > text.size())
+        return false;
+      value = 0;
+      for (auto i = pos; i < pos + count; i++)
+      {
+        auto c = text[i];
+        if (c < '0' || c > '9')
+          return false;
+        value = value * 10 + (c - '0');
+      }
+      return true;
+    };
+
+    // Date
+    if (text.size() < 10 || text[4] != '-' || text[7] != '-')
+      return std::nullopt;
+
+    struct DateCache
+    {
+      char m_text[10];
+      date::sys_days m_days;
+      bool m_valid {false};
+    };
+    static thread_local DateCache cache;
+
+    date::sys_days days;
+    if (cache.m_valid && text.compare(0, 10, std::string_view(cache.m_text, 10)) == 0)
+    {
+      days = cache.m_days;
+    }
+    else
+    {
+      int y, m, d;
+      if (!digits(0, 4, y) || !digits(5, 2, m) || !digits(8, 2, d))
+        return std::nullopt;
+      date::year_month_day ymd {date::year(y), date::month(unsigned(m)), date::day(unsigned(d))};
+      if (!ymd.ok())
+        return std::nullopt;
+
+      days = date::sys_days(ymd);
+      text.copy(cache.m_text, 10);
+      cache.m_days = days;
+      cache.m_valid = true;
+    }
+
+    if (text.size() == 10 || text[10] != 'T')
+      return Timestamp(days);
+
+    // Time
+    int h, mi, s;
+    if (!digits(11, 2, h) || text.size() < 19 || text[13] != ':' || !digits(14, 2, mi) ||
+        text[16] != ':' || !digits(17, 2, s) || h > 23 || mi > 59 || s > 59)
+      return std::nullopt;
+
+    size_t pos = 19;
+    Timestamp::duration fraction {0};
+    if (pos < text.size() && text[pos] == '.')
+    {
+      using Rep = Timestamp::duration::rep;
+      Rep value {0}, scale {Timestamp::period::den / Timestamp::period::num};
+      for (pos++; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; pos++)
+      {
+        if (scale > 1)
+        {
+          scale /= 10;
+          value += (text[pos] - '0') * scale;
+        }
+      }
+      fraction = Timestamp::duration(value);
+    }
+
+    // Time zone
+    seconds offset {0};
+    if (pos < text.size() && (text[pos] == '+' || text[pos] == '-'))
     {
-      if (time[pos] != '.')
-        pos++;
-      time.erase(pos);
+      int oh, om {0};
+      if (digits(pos + 1, 2, oh))
+      {
+        auto mp = pos + 3;
+        if (mp < text.size() && text[mp] == ':')
+          mp++;
+        if (!digits(mp, 2, om))
+          om = 0;
+        offset = hours(oh) + minutes(om);
+        if (text[pos] == '-')
+          offset = -offset;
+      }
     }
-    time.append("Z");
-    return time;
+
+    return Timestamp(days) + hours(h) + minutes(mi) + seconds(s) + fraction - offset;
   }
 
   inline void capitalize(std::string::iterator start, std::string::iterator end)
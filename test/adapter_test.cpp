@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "configuration/config_options.hpp"
+#include "observation/observation.hpp"
 #include "pipeline/pipeline_context.hpp"
 #include "source/adapter/shdr/shdr_adapter.hpp"
 
@@ -68,3 +69,242 @@ Another Line...
 --multiline--ABC---)DOC";
   EXPECT_EQ(exp, data);
 }
+
+TEST(AdapterTest, should_batch_the_lines_from_a_read)
+{
+  asio::io_context ioc;
+  asio::io_context::strand strand(ioc);
+  ConfigOptions options {{configuration::Host, "localhost"s}, {configuration::Port, 7878}};
+  boost::property_tree::ptree tree;
+  pipeline::PipelineContextPtr context = make_shared<pipeline::PipelineContext>();
+  auto adapter = make_unique<ShdrAdapter>(ioc, context, options, tree);
+
+  auto handler = make_unique<Handler>();
+  vector<string> events;
+  handler->m_processLines = [&](list<string> &lines, const string &s) {
+    string batch = "batch:";
+    for (auto &l : lines)
+      batch += " " + l;
+    events.emplace_back(batch);
+  };
+  handler->m_processData = [&](const string &d, const string &s) {
+    events.emplace_back("data: " + d);
+  };
+  handler->m_command = [&](const string &d, const string &s) {
+    events.emplace_back("command: " + d);
+  };
+  adapter->setHandler(handler);
+
+  adapter->parseBuffer(
+      "2021-01-01T00:00:00Z|a|1\n"
+      "2021-01-01T00:00:01Z|a|2\n"
+      "\n"
+      "* uuid: 12345\n"
+      "2021-01-01T00:00:02Z|a|3\n"
+      "multi --multiline--ABC\n"
+      "body\n"
+      "--multiline--ABC\n"
+      "2021-01-01T00:00:03Z|a|4\n"
+      "2021-01-01T00:00:04Z|a|5\n"
+      "2021-01-01T00:00:05Z|a|");
+
+  vector<string> expected {"batch: 2021-01-01T00:00:00Z|a|1 2021-01-01T00:00:01Z|a|2",
+                           "command: * uuid: 12345", "batch: 2021-01-01T00:00:02Z|a|3",
+                           "data: multi \nbody",
+                           "batch: 2021-01-01T00:00:03Z|a|4 2021-01-01T00:00:04Z|a|5"};
+  EXPECT_EQ(expected, events);
+
+  // The incomplete line is held until the rest arrives
+  events.clear();
+  adapter->parseBuffer("6\n");
+  EXPECT_EQ((vector<string> {"batch: 2021-01-01T00:00:05Z|a|6"}), events);
+}
+
+class MockPipelineContract : public pipeline::PipelineContract
+{
+public:
+  DevicePtr findDevice(const std::string &) override { return nullptr; }
+  DataItemPtr findDataItem(const std::string &device, const std::string &name) override
+  {
+    m_lookups++;
+    return m_dataItems[name];
+  }
+  std::optional<uint64_t> deviceGeneration() const override { return 1; }
+  void eachDataItem(EachDataItem fun) override {}
+  void deliverObservation(observation::ObservationPtr obs) override {}
+  void deliverAsset(asset::AssetPtr) override {}
+  void deliverDevice(DevicePtr) override {}
+  void deliverAssetCommand(entity::EntityPtr) override {}
+  void deliverCommand(entity::EntityPtr) override {}
+  void deliverConnectStatus(entity::EntityPtr, const StringList &, bool) override {}
+  void sourceFailed(const std::string &id) override {}
+
+  std::map<string, DataItemPtr> m_dataItems;
+  int m_lookups {0};
+};
+
+TEST(AdapterTest, should_map_binary_frames_to_observations)
+{
+  using namespace observation;
+  using namespace device_model::data_item;
+
+  asio::io_context ioc;
+  asio::io_context::strand strand(ioc);
+  ConfigOptions options {{configuration::Host, "localhost"s}, {configuration::Port, 7878}};
+  boost::property_tree::ptree tree;
+  pipeline::PipelineContextPtr context = make_shared<pipeline::PipelineContext>();
+  auto contract = new MockPipelineContract();
+  context->m_contract.reset(contract);
+
+  entity::ErrorList errors;
+  auto load = DataItem::make(
+      {{"id", "load"s}, {"type", "LOAD"s}, {"category", "SAMPLE"s}, {"units", "PERCENT"s}},
+      errors);
+  auto vib = DataItem::make({{"id", "vib"s},
+                             {"type", "DISPLACEMENT"s},
+                             {"category", "SAMPLE"s},
+                             {"units", "MILLIMETER"s},
+                             {"representation", "TIME_SERIES"s}},
+                            errors);
+  ASSERT_TRUE(errors.empty());
+  contract->m_dataItems = {{"load", load}, {"vib", vib}};
+
+  auto adapter = make_unique<ShdrAdapter>(ioc, context, options, tree);
+
+  auto handler = make_unique<Handler>();
+  vector<string> events;
+  list<ObservationPtr> observations;
+  handler->m_processObservations = [&](entity::EntityList &entities, const string &s) {
+    events.emplace_back("observations: " + to_string(entities.size()));
+    for (auto &e : entities)
+      observations.emplace_back(dynamic_pointer_cast<Observation>(e));
+  };
+  handler->m_processLines = [&](list<string> &lines, const string &s) {
+    for (auto &l : lines)
+      events.emplace_back("line: " + l);
+  };
+  handler->m_processData = [&](const string &d, const string &s) {
+    events.emplace_back("data: " + d);
+  };
+  adapter->setHandler(handler);
+
+  string buffer = "* protocol: binary\n";
+  BinaryFrame::encodeDefine(buffer, 0, "load");
+  BinaryFrame::encodeDefine(buffer, 1, "vib");
+  BinaryFrame::encodeSample(buffer, 1609459200000000LL, 0, 42.5);
+  BinaryFrame::encodeVector(buffer, 1609459200500000LL, 1, 100.0, {1.0, 2.0, 3.0});
+  BinaryFrame::encodeSample(buffer, 1609459201000000LL, 0, std::nan(""));
+  BinaryFrame::encodeText(buffer, "2021-01-01T00:00:02Z|other|1");
+  BinaryFrame::encodeSample(buffer, 1609459203000000LL, 3, 1.0);
+  BinaryFrame::encodeText(buffer, "* protocol: text");
+  buffer += "2021-01-01T00:00:04Z|other|2\n";
+
+  // Split the buffer in the middle of a frame
+  auto split = buffer.size() / 2;
+  adapter->parseBuffer(buffer.data(), split);
+  ASSERT_TRUE(adapter->isBinary());
+  adapter->parseBuffer(buffer.data() + split, buffer.size() - split);
+  ASSERT_FALSE(adapter->isBinary());
+
+  vector<string> expected {"observations: 2", "observations: 1",
+                           "data: 2021-01-01T00:00:02Z|other|1",
+                           "line: 2021-01-01T00:00:04Z|other|2"};
+  EXPECT_EQ(expected, events);
+  EXPECT_EQ(2, contract->m_lookups);
+
+  ASSERT_EQ(3, observations.size());
+  auto it = observations.begin();
+
+  auto sample = dynamic_pointer_cast<Sample>(*it++);
+  ASSERT_TRUE(sample);
+  EXPECT_EQ(load, sample->getDataItem());
+  EXPECT_EQ(42.5, sample->getValue<double>());
+  EXPECT_EQ("2021-01-01T00:00:00Z", format(sample->getTimestamp()));
+
+  auto series = dynamic_pointer_cast<Timeseries>(*it++);
+  ASSERT_TRUE(series);
+  EXPECT_EQ(vib, series->getDataItem());
+  EXPECT_EQ((entity::Vector {1.0, 2.0, 3.0}), series->getValue<entity::Vector>());
+  EXPECT_EQ(3, series->get<int64_t>("sampleCount"));
+  EXPECT_EQ(100.0, series->get<double>("sampleRate"));
+
+  auto unavailable = *it++;
+  EXPECT_EQ(load, unavailable->getDataItem());
+  EXPECT_TRUE(unavailable->isUnavailable());
+}
+
+// Creates an adapter mapping the binary index 0 to a load sample
+static unique_ptr<ShdrAdapter> makeFrameAdapter(asio::io_context &ioc, ConfigOptions options,
+                                                list<observation::ObservationPtr> &observations)
+{
+  using namespace device_model::data_item;
+
+  options.emplace(configuration::Host, "localhost"s);
+  options.emplace(configuration::Port, 7878);
+  boost::property_tree::ptree tree;
+  pipeline::PipelineContextPtr context = make_shared<pipeline::PipelineContext>();
+  auto contract = new MockPipelineContract();
+  context->m_contract.reset(contract);
+
+  entity::ErrorList errors;
+  contract->m_dataItems["load"] = DataItem::make(
+      {{"id", "load"s}, {"type", "LOAD"s}, {"category", "SAMPLE"s}, {"units", "PERCENT"s}},
+      errors);
+
+  auto adapter = make_unique<ShdrAdapter>(ioc, context, options, tree);
+
+  auto handler = make_unique<Handler>();
+  handler->m_processObservations = [&observations](entity::EntityList &entities,
+                                                   const string &s) {
+    for (auto &e : entities)
+      observations.emplace_back(dynamic_pointer_cast<observation::Observation>(e));
+  };
+  adapter->setHandler(handler);
+
+  string buffer = "* protocol: binary\n";
+  BinaryFrame::encodeDefine(buffer, 0, "load");
+  adapter->parseBuffer(buffer.data(), buffer.size());
+
+  return adapter;
+}
+
+TEST(AdapterTest, should_ignore_binary_frame_timestamps_when_option_is_set)
+{
+  asio::io_context ioc;
+  list<observation::ObservationPtr> observations;
+  auto adapter = makeFrameAdapter(ioc, {{configuration::IgnoreTimestamps, true}}, observations);
+
+  auto start = chrono::system_clock::now();
+  string buffer;
+  BinaryFrame::encodeSample(buffer, 1609459200000000LL, 0, 42.5);
+  BinaryFrame::encodeSample(buffer, 1609459201000000LL, 0, 43.5);
+  adapter->parseBuffer(buffer.data(), buffer.size());
+
+  ASSERT_EQ(2, observations.size());
+  for (auto &obs : observations)
+  {
+    EXPECT_LE(start, obs->getTimestamp());
+    EXPECT_GE(chrono::system_clock::now(), obs->getTimestamp());
+  }
+}
+
+TEST(AdapterTest, should_apply_relative_time_to_binary_frame_timestamps)
+{
+  asio::io_context ioc;
+  list<observation::ObservationPtr> observations;
+  auto adapter = makeFrameAdapter(ioc, {{configuration::RelativeTime, true}}, observations);
+
+  // The first timestamp is the base, later ones keep their offset from it
+  auto start = chrono::system_clock::now();
+  string buffer;
+  BinaryFrame::encodeSample(buffer, 1609459200000000LL, 0, 42.5);
+  BinaryFrame::encodeSample(buffer, 1609459201500000LL, 0, 43.5);
+  adapter->parseBuffer(buffer.data(), buffer.size());
+
+  ASSERT_EQ(2, observations.size());
+  auto first = observations.front()->getTimestamp();
+  auto second = observations.back()->getTimestamp();
+  EXPECT_LE(start, first);
+  EXPECT_GE(chrono::system_clock::now(), first);
+  EXPECT_EQ(1500000, chrono::round<chrono::microseconds>(second - first).count());
+}
@@ -34,6 +34,7 @@
 #include "printer/xml_printer.hpp"
 #include "source/adapter/adapter.hpp"
 #include "source/adapter/agent_adapter/agent_adapter.hpp"
+#include "source/adapter/agent_adapter/shared_tls_context.hpp"
 #include "source/adapter/agent_adapter/url_parser.hpp"
 #include "test_utilities.hpp"
 
@@ -338,6 +339,180 @@ TEST_F(AgentAdapterTest, should_receive_sample)
   timeout.cancel();
 }
 
+TEST_F(AgentAdapterTest, should_receive_parts_larger_than_a_megabyte)
+{
+  createAgent();
+
+  auto port = m_agentTestHelper->m_restService->getServer()->getPort();
+  auto adapter = createAdapter(port);
+
+  addAdapter();
+
+  unique_ptr<source::adapter::Handler> handler = make_unique<Handler>();
+
+  int rc = 0;
+  ResponseDocument rd;
+  handler->m_processData = [&](const string &d, const string &s) {
+    ResponseDocument::parse(d, rd, m_context);
+    rc++;
+
+    adapter->getFeedback().m_next = rd.m_next;
+  };
+  handler->m_connecting = [&](const string id) {};
+  handler->m_connected = [&](const string id) {};
+
+  adapter->setHandler(handler);
+  adapter->start();
+
+  boost::asio::steady_timer timeout(m_agentTestHelper->m_ioContext, 5s);
+  timeout.async_wait([](boost::system::error_code ec) {
+    if (!ec)
+    {
+      throw runtime_error("test timed out");
+    }
+  });
+
+  while (rc < 2)
+  {
+    m_agentTestHelper->m_ioContext.run_one();
+  }
+  ASSERT_EQ(2, rc);
+
+  string line(1536 * 1024, 'L');
+  m_agentTestHelper->m_adapter->processData("2021-02-01T12:00:00Z|line|" + line);
+
+  rd.m_entities.clear();
+  while (rc < 3)
+  {
+    m_agentTestHelper->m_ioContext.run_one();
+  }
+  ASSERT_EQ(3, rc);
+  ASSERT_EQ(1, rd.m_entities.size());
+
+  auto obs = rd.m_entities.front();
+  ASSERT_EQ("p3", get<string>(obs->getProperty("dataItemId")));
+  ASSERT_EQ(line, obs->getValue<string>());
+
+  timeout.cancel();
+}
+
+TEST_F(AgentAdapterTest, should_restart_the_stream_when_a_part_exceeds_the_maximum_size)
+{
+  createAgent();
+
+  auto port = m_agentTestHelper->m_restService->getServer()->getPort();
+  auto adapter = createAdapter(port, {{configuration::MaxPartSize, 1024 * 1024}});
+
+  addAdapter();
+
+  unique_ptr<source::adapter::Handler> handler = make_unique<Handler>();
+
+  int rc = 0;
+  ResponseDocument rd;
+  handler->m_processData = [&](const string &d, const string &s) {
+    ResponseDocument::parse(d, rd, m_context);
+    rc++;
+
+    adapter->getFeedback().m_next = rd.m_next;
+    adapter->getFeedback().m_instanceId = rd.m_instanceId;
+  };
+  handler->m_connecting = [&](const string id) {};
+  handler->m_connected = [&](const string id) {};
+
+  bool disconnected = false;
+  handler->m_disconnected = [&](const string id) { disconnected = true; };
+
+  adapter->setHandler(handler);
+  adapter->start();
+
+  boost::asio::steady_timer timeout(m_agentTestHelper->m_ioContext, 5s);
+  timeout.async_wait([](boost::system::error_code ec) {
+    if (!ec)
+    {
+      throw runtime_error("test timed out");
+    }
+  });
+
+  while (rc < 2)
+  {
+    m_agentTestHelper->m_ioContext.run_one();
+  }
+  ASSERT_EQ(2, rc);
+
+  string line(1536 * 1024, 'L');
+  m_agentTestHelper->m_adapter->processData("2021-02-01T12:00:00Z|line|" + line);
+
+  while (!disconnected)
+  {
+    m_agentTestHelper->m_ioContext.run_one();
+  }
+  ASSERT_EQ(2, rc);
+
+  timeout.cancel();
+}
+
+TEST_F(AgentAdapterTest, should_receive_json_sample)
+{
+  createAgent();
+
+  auto port = m_agentTestHelper->m_restService->getServer()->getPort();
+  auto adapter = createAdapter(port, {{configuration::UpstreamFormat, "json"s}});
+
+  addAdapter();
+
+  unique_ptr<source::adapter::Handler> handler = make_unique<Handler>();
+
+  int rc = 0;
+  int json = 0;
+  ResponseDocument rd;
+  handler->m_processData = [&](const string &d, const string &s) {
+    if (d.find("MTConnectStreams") != string::npos && d[0] == '{')
+      json++;
+    ResponseDocument::parse(d, rd, m_context);
+    rc++;
+
+    adapter->getFeedback().m_next = rd.m_next;
+  };
+  handler->m_connecting = [&](const string id) {};
+  handler->m_connected = [&](const string id) {};
+
+  adapter->setHandler(handler);
+  adapter->start();
+
+  boost::asio::steady_timer timeout(m_agentTestHelper->m_ioContext, 500ms);
+  timeout.async_wait([](boost::system::error_code ec) {
+    if (!ec)
+    {
+      throw runtime_error("test timed out");
+    }
+  });
+
+  while (rc < 2)
+  {
+    m_agentTestHelper->m_ioContext.run_one();
+  }
+  ASSERT_EQ(2, rc);
+  ASSERT_EQ(1, json);
+  ASSERT_NE(0, rd.m_next);
+
+  m_agentTestHelper->m_adapter->processData("2021-02-01T12:00:00Z|execution|READY");
+
+  rd.m_entities.clear();
+  while (rc < 3)
+  {
+    m_agentTestHelper->m_ioContext.run_one();
+  }
+  ASSERT_EQ(3, rc);
+  ASSERT_EQ(2, json);
+  ASSERT_EQ(1, rd.m_entities.size());
+
+  auto obs = rd.m_entities.front();
+  ASSERT_EQ("p5", get<string>(obs->getProperty("dataItemId")));
+  ASSERT_EQ("READY", obs->getValue<string>());
+
+  timeout.cancel();
+}
+
 TEST_F(AgentAdapterTest, should_reconnect)
 {
   createAgent();
@@ -708,3 +883,184 @@ TEST_F(AgentAdapterTest, should_connect_to_tls_agent)
 
   timeout.cancel();
 }
+
+TEST_F(AgentAdapterTest, should_tune_count_and_interval_from_the_upstream_lag)
+{
+  createAgent();
+
+  auto port = m_agentTestHelper->m_restService->getServer()->getPort();
+  auto adapter = createAdapter(port, {{configuration::MaxCount, 400},
+                                      {configuration::PollingInterval, Milliseconds(400)}});
+
+  auto tuner = adapter->getTuner();
+  ASSERT_EQ(100, tuner.count());
+  ASSERT_EQ(400ms, tuner.interval());
+
+  // Caught up or a partial response behind leaves the request alone
+  ASSERT_FALSE(tuner.update(0));
+  ASSERT_FALSE(tuner.update(99));
+
+  // Falling behind doubles the count up to MaxCount and halves the interval
+  ASSERT_TRUE(tuner.update(100));
+  ASSERT_EQ(200, tuner.count());
+  ASSERT_EQ(200ms, tuner.interval());
+
+  ASSERT_TRUE(tuner.update(5000));
+  ASSERT_EQ(400, tuner.count());
+  ASSERT_EQ(100ms, tuner.interval());
+
+  // Once the count is capped the interval is not lowered any further
+  ASSERT_FALSE(tuner.update(5000));
+  ASSERT_EQ(100ms, tuner.interval());
+
+  ASSERT_FALSE(tuner.update(50));
+
+  // Once caught up the configured values are restored
+  ASSERT_TRUE(tuner.update(0));
+  ASSERT_EQ(100, tuner.count());
+  ASSERT_EQ(400ms, tuner.interval());
+
+  // The interval does not go below an eighth of the configured interval
+  SampleTuner wide(100, 100000, 400ms);
+  for (int i = 0; i < 10; i++)
+    wide.update(1000000);
+  ASSERT_EQ(100000, wide.count());
+  ASSERT_EQ(50ms, wide.interval());
+}
+
+TEST_F(AgentAdapterTest, should_reissue_the_stream_with_the_tuned_count)
+{
+  createAgent();
+
+  auto port = m_agentTestHelper->m_restService->getServer()->getPort();
+  auto adapter =
+      createAdapter(port, {{configuration::Count, 5}, {configuration::MaxCount, 40}});
+
+  addAdapter();
+
+  unique_ptr<source::adapter::Handler> handler = make_unique<Handler>();
+
+  int rc = 0;
+  size_t largest = 0;
+  ResponseDocument rd;
+  handler->m_processData = [&](const string &d, const string &s) {
+    rd.m_entities.clear();
+    ResponseDocument::parse(d, rd, m_context);
+    rc++;
+
+    auto &feedback = adapter->getFeedback();
+    feedback.m_next = rd.m_next;
+    feedback.m_last = rd.m_last;
+    feedback.m_instanceId = rd.m_instanceId;
+    if (rc > 1)
+      largest = std::max(largest, rd.m_entities.size());
+  };
+  handler->m_connecting = [&](const string id) {};
+  handler->m_connected = [&](const string id) {};
+
+  adapter->setHandler(handler);
+  adapter->start();
+
+  boost::asio::steady_timer timeout(m_agentTestHelper->m_ioContext, 5s);
+  timeout.async_wait([](boost::system::error_code ec) {
+    if (!ec)
+    {
+      throw runtime_error("test timed out");
+    }
+  });
+
+  while (rc < 2)
+  {
+    m_agentTestHelper->m_ioContext.run_one();
+  }
+  ASSERT_EQ(5, adapter->getTuner().count());
+
+  // Fall behind the upstream agent by more than one response can carry
+  for (int i = 0; i < 60; i++)
+    m_agentTestHelper->m_adapter->processData("2021-02-01T12:00:00Z|line|" + to_string(i));
+
+  while (largest <= 5)
+  {
+    m_agentTestHelper->m_ioContext.run_one();
+  }
+
+  ASSERT_LT(5, adapter->getTuner().count());
+  ASSERT_LT(5, largest);
+  ASSERT_GE(40, largest);
+
+  timeout.cancel();
+}
+
+TEST_F(AgentAdapterTest, should_share_one_tls_context_per_io_context)
+{
+  createAgent();
+
+  auto &ioc = m_agentTestHelper->m_ioContext;
+  auto tls = SharedTlsContext::get(ioc);
+  ASSERT_EQ(tls, SharedTlsContext::get(ioc));
+
+  boost::asio::io_context other;
+  ASSERT_NE(tls, SharedTlsContext::get(other));
+}
+
+TEST_F(AgentAdapterTest, should_resume_the_tls_session_on_the_next_handshake)
+{
+  using namespace mtconnect::configuration;
+  namespace ssl = boost::asio::ssl;
+  using tcp = boost::asio::ip::tcp;
+
+  createAgent({{{TlsCertificateChain, CertFile},
+                {TlsPrivateKey, KeyFile},
+                {TlsDHKey, DhFile},
+                {TlsCertificatePassword, "mtconnect"s}}});
+
+  auto &ioc = m_agentTestHelper->m_ioContext;
+  auto port = m_agentTestHelper->m_restService->getServer()->getPort();
+  tcp::endpoint server(boost::asio::ip::make_address("127.0.0.1"), port);
+  auto upstream = "127.0.0.1:"s + boost::lexical_cast<string>(port);
+  auto tls = SharedTlsContext::get(ioc);
+
+  boost::asio::steady_timer timeout(ioc, 5s);
+  timeout.async_wait([](boost::system::error_code ec) {
+    if (!ec)
+    {
+      throw runtime_error("test timed out");
+    }
+  });
+
+  // Handshakes the same way the https session does and drops the connection without a
+  // close_notify
+  auto handshake = [&]() {
+    ssl::stream<tcp::socket> stream(ioc, tls->context());
+    tls->resume(stream.native_handle(), upstream);
+
+    bool done = false;
+    boost::system::error_code result;
+    stream.next_layer().async_connect(server, [&](boost::system::error_code ec) {
+      if (ec)
+      {
+        result = ec;
+        done = true;
+      }
+      else
+        stream.async_handshake(ssl::stream_base::client, [&](boost::system::error_code ec) {
+          result = ec;
+          done = true;
+        });
+    });
+    while (!done)
+      ioc.run_one();
+    EXPECT_FALSE(result) << result.message();
+
+    bool reused = SSL_session_reused(stream.native_handle());
+    if (!reused)
+      tls->save(stream.native_handle(), upstream);
+    stream.next_layer().close();
+    return reused;
+  };
+
+  ASSERT_FALSE(handshake());
+  ASSERT_TRUE(handshake());
+
+  timeout.cancel();
+}
@@ -19,6 +19,7 @@
 #include <gtest/gtest.h>
 // Keep this comment to keep gtest.h above. (clang-format off/on is not working here!)
 
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <map>
@@ -2870,3 +2871,144 @@ TEST_F(AgentTest, asset_should_also_work_using_post_with_assets)
   }
   
 }
+
+TEST_F(AgentTest, should_render_current_concurrently_while_ingesting)
+{
+  addAdapter();
+
+  auto rest = m_agentTestHelper->getRestService();
+  auto printer = m_agentTestHelper->m_agent->getPrinter("xml");
+  ASSERT_NE(nullptr, printer);
+
+  const int readers = 4;
+  const int iterations = 200;
+  atomic_int failures {0};
+
+  vector<thread> threads;
+  for (int r = 0; r < readers; r++)
+  {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < iterations; i++)
+      {
+        auto doc = rest->fetchCurrentData(printer, nullopt, nullopt);
+        if (doc.find("</MTConnectStreams>") == string::npos)
+          failures++;
+      }
+    });
+  }
+
+  char line[80] = {0};
+  for (int i = 1; i <= 1000; i++)
+  {
+    sprintf(line, "2021-02-01T12:00:00Z|line|%d", i);
+    m_agentTestHelper->m_adapter->processData(line);
+  }
+
+  for (auto &t : threads)
+    t.join();
+
+  ASSERT_EQ(0, failures);
+
+  {
+    PARSE_XML_RESPONSE("/current");
+    ASSERT_XML_PATH_EQUAL(doc, "//m:DeviceStream//m:Line", "1000");
+  }
+}
+
+TEST_F(AgentTest, should_limit_request_rate_per_client)
+{
+  using namespace configuration;
+  ConfigOptions options {{MaxRequestRate, 0.001}, {MaxRequestBurst, 2}};
+  m_agentTestHelper->createAgent("/samples/test_config.xml", 8, 4, "1.3", 25, true, true,
+                                 options);
+
+  {
+    PARSE_XML_RESPONSE("/probe");
+    ASSERT_EQ(status::ok, m_agentTestHelper->session()->m_code);
+  }
+  {
+    PARSE_XML_RESPONSE("/current");
+    ASSERT_EQ(status::ok, m_agentTestHelper->session()->m_code);
+  }
+  {
+    PARSE_XML_RESPONSE("/current");
+    ASSERT_EQ(status::too_many_requests, m_agentTestHelper->session()->m_code);
+    ASSERT_XML_PATH_EQUAL(doc, "//m:Error@errorCode", "INVALID_REQUEST");
+    ASSERT_TRUE(m_agentTestHelper->m_dispatched);
+  }
+}
+
+TEST_F(AgentTest, should_reject_samples_larger_than_max_sample_count)
+{
+  using namespace configuration;
+  ConfigOptions options {{MaxSampleCount, 5}};
+  m_agentTestHelper->createAgent("/samples/test_config.xml", 8, 4, "1.3", 25, true, true,
+                                 options);
+
+  QueryMap query {{"count", "6"}};
+  {
+    PARSE_XML_RESPONSE_QUERY("/sample", query);
+    ASSERT_EQ(status::too_many_requests, m_agentTestHelper->session()->m_code);
+    ASSERT_XML_PATH_EQUAL(doc, "//m:Error@errorCode", "TOO_MANY");
+    ASSERT_TRUE(m_agentTestHelper->m_dispatched);
+  }
+
+  query["count"] = "5";
+  {
+    PARSE_XML_RESPONSE_QUERY("/sample", query);
+    ASSERT_EQ(status::ok, m_agentTestHelper->session()->m_code);
+  }
+}
+
+TEST_F(AgentTest, should_cache_current_until_the_sequence_changes)
+{
+  addAdapter();
+
+  auto rest = m_agentTestHelper->getRestService();
+  auto printer = m_agentTestHelper->m_agent->getPrinter("xml");
+
+  auto first = rest->currentRequest(printer);
+  ASSERT_EQ(status::ok, first->m_status);
+  ASSERT_TRUE(first->m_etag);
+
+  auto second = rest->currentRequest(printer);
+  ASSERT_EQ(status::ok, second->m_status);
+  ASSERT_EQ(*first->m_etag, *second->m_etag);
+  ASSERT_EQ(first->m_body, second->m_body);
+
+  auto notModified = rest->currentRequest(printer, nullopt, nullopt, nullopt, first->m_etag);
+  ASSERT_EQ(status::not_modified, notModified->m_status);
+  ASSERT_TRUE(notModified->m_body.empty());
+
+  auto filtered = rest->currentRequest(printer, nullopt, nullopt, "//DataItem[@type='LINE']"s);
+  ASSERT_NE(*first->m_etag, *filtered->m_etag);
+
+  m_agentTestHelper->m_adapter->processData("2021-02-01T12:00:00Z|line|204");
+
+  auto changed = rest->currentRequest(printer, nullopt, nullopt, nullopt, first->m_etag);
+  ASSERT_EQ(status::ok, changed->m_status);
+  ASSERT_NE(*first->m_etag, *changed->m_etag);
+  ASSERT_NE(string::npos, changed->m_body.find(">204<"));
+}
+
+TEST_F(AgentTest, should_match_if_none_match_lists_wildcards_and_weak_tags)
+{
+  addAdapter();
+
+  auto rest = m_agentTestHelper->getRestService();
+  auto printer = m_agentTestHelper->m_agent->getPrinter("xml");
+
+  auto first = rest->currentRequest(printer);
+  ASSERT_EQ(status::ok, first->m_status);
+  auto etag = *first->m_etag;
+
+  for (auto header : {"\"other\", "s + etag, "W/"s + etag, " \"other\" , W/"s + etag + " ", "*"s})
+  {
+    auto response = rest->currentRequest(printer, nullopt, nullopt, nullopt, header);
+    ASSERT_EQ(status::not_modified, response->m_status) << header;
+    ASSERT_EQ(etag, *response->m_etag) << header;
+  }
+
+  auto other = rest->currentRequest(printer, nullopt, nullopt, nullopt, "\"other\", W/\"x\""s);
+  ASSERT_EQ(status::ok, other->m_status);
+}
@@ -0,0 +1,134 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+// Ensure that gtest is the first header otherwise Windows raises an error
+#include <gtest/gtest.h>
+// Keep this comment to keep gtest.h above. (clang-format off/on is not working here!)
+
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "agent.hpp"
+#include "agent_test_helper.hpp"
+#include "printer/cbor_printer.hpp"
+#include "printer/json_printer.hpp"
+#include "test_utilities.hpp"
+
+using json = nlohmann::json;
+using namespace std;
+using namespace mtconnect;
+using namespace mtconnect::printer;
+using namespace mtconnect::sink::rest_sink;
+
+using status = boost::beast::http::status;
+
+class CborPrinterTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_agentTestHelper = make_unique<AgentTestHelper>();
+    m_agentTestHelper->createAgent("/samples/test_config.xml", 8, 4, "2.0", 25, true);
+    m_agentTestHelper->addAdapter({}, "localhost", 7878,
+                                  m_agentTestHelper->m_agent->defaultDevice()->getName());
+  }
+
+  void TearDown() override { m_agentTestHelper.reset(); }
+
+  json request(const char *path, const char *accepts)
+  {
+    m_agentTestHelper->makeRequest(__FILE__, __LINE__, boost::beast::http::verb::get, "", {},
+                                   path, accepts);
+    EXPECT_EQ(status::ok, m_agentTestHelper->session()->m_code);
+    const auto &body = m_agentTestHelper->session()->m_body;
+    if (ends_with(m_agentTestHelper->session()->m_mimeType, "cbor"))
+      return CborPrinter::decode(body);
+    else
+      return json::parse(body);
+  }
+
+  // The creation time is generated for each document
+  static void stripCreationTime(json &doc)
+  {
+    for (auto &root : doc)
+      root["Header"].erase("creationTime");
+  }
+
+  std::unique_ptr<AgentTestHelper> m_agentTestHelper;
+};
+
+TEST_F(CborPrinterTest, should_be_selected_by_accept_header)
+{
+  auto printer = m_agentTestHelper->getRestService()->printerForAccepts(
+      "application/mtconnect+cbor");
+  ASSERT_NE(nullptr, dynamic_cast<const CborPrinter *>(printer));
+  ASSERT_EQ("application/mtconnect+cbor", printer->mimeType());
+
+  m_agentTestHelper->makeRequest(__FILE__, __LINE__, boost::beast::http::verb::get, "", {},
+                                 "/current", "application/mtconnect+cbor");
+  ASSERT_EQ("application/mtconnect+cbor", m_agentTestHelper->session()->m_mimeType);
+}
+
+TEST_F(CborPrinterTest, should_round_trip_current_document)
+{
+  m_agentTestHelper->m_adapter->processData("2021-02-01T12:00:00Z|line|204|Xact|100.5");
+
+  auto cbor = request("/current", "application/mtconnect+cbor");
+  auto doc = request("/current", "application/json");
+
+  stripCreationTime(cbor);
+  stripCreationTime(doc);
+  ASSERT_EQ(doc, cbor);
+  ASSERT_TRUE(cbor["MTConnectStreams"]["Streams"].is_object() ||
+              cbor["MTConnectStreams"]["Streams"].is_array());
+}
+
+TEST_F(CborPrinterTest, should_round_trip_samples_and_be_smaller_than_json)
+{
+  for (int i = 0; i < 50; i++)
+    m_agentTestHelper->m_adapter->processData("2021-02-01T12:00:00Z|Xact|" + to_string(i) +
+                                              ".25");
+
+  QueryMap query {{"count", "50"}};
+  m_agentTestHelper->makeRequest(__FILE__, __LINE__, boost::beast::http::verb::get, "", query,
+                                 "/sample", "application/mtconnect+cbor");
+  auto cborBody = m_agentTestHelper->session()->m_body;
+  auto cbor = CborPrinter::decode(cborBody);
+
+  m_agentTestHelper->makeRequest(__FILE__, __LINE__, boost::beast::http::verb::get, "", query,
+                                 "/sample", "application/json");
+  auto jsonBody = m_agentTestHelper->session()->m_body;
+  auto doc = json::parse(jsonBody);
+
+  stripCreationTime(cbor);
+  stripCreationTime(doc);
+  ASSERT_EQ(doc, cbor);
+  ASSERT_LT(cborBody.size(), jsonBody.size());
+}
+
+TEST_F(CborPrinterTest, should_encode_probe_and_errors)
+{
+  auto probe = request("/probe", "application/mtconnect+cbor");
+  ASSERT_TRUE(probe.contains("MTConnectDevices"));
+
+  m_agentTestHelper->makeRequest(__FILE__, __LINE__, boost::beast::http::verb::get, "", {},
+                                 "/NoDevice/current", "application/mtconnect+cbor");
+  ASSERT_EQ(status::not_found, m_agentTestHelper->session()->m_code);
+  auto error = CborPrinter::decode(m_agentTestHelper->session()->m_body);
+  ASSERT_TRUE(error.contains("MTConnectError"));
+}
@@ -530,3 +530,67 @@ TEST_F(ConnectorTest, test_trimming_trailing_white_space)
   ASSERT_EQ((string) "fourth", m_connector->m_list[3]);
   ASSERT_EQ((string) "r", m_connector->m_list[4]);
 }
+
+TEST_F(ConnectorTest, should_fire_timer_wheel_timers_after_their_deadlines)
+{
+  auto wheel = TimerWheel::get(m_context);
+  ASSERT_EQ(wheel, TimerWheel::get(m_context));
+
+  auto start = steady_clock::now();
+  steady_clock::time_point first, moved, pushed;
+  bool cancelled = false;
+  uint64_t fired = 0;
+
+  auto t1 = wheel->makeTimer([&](uint64_t epoch) {
+    first = steady_clock::now();
+    fired = epoch;
+  });
+  auto t2 = wheel->makeTimer([&](uint64_t) { moved = steady_clock::now(); });
+  auto t3 = wheel->makeTimer([&](uint64_t) { pushed = steady_clock::now(); });
+  auto t4 = wheel->makeTimer([&](uint64_t) { cancelled = true; });
+
+  t1->expiresAfter(100ms);
+  t2->expiresAfter(30s);
+  t2->expiresAfter(200ms);
+  t3->expiresAfter(100ms);
+  t3->expiresAfter(300ms);
+  t4->expiresAfter(150ms);
+  t4->cancel();
+
+  m_context.run_for(500ms);
+
+  ASSERT_GE(first - start, 100ms);
+  ASSERT_GE(moved - start, 200ms);
+  ASSERT_GE(pushed - start, 300ms);
+  ASSERT_LT(first, moved);
+  ASSERT_LT(moved, pushed);
+  ASSERT_FALSE(cancelled);
+  ASSERT_FALSE(t1->isArmed());
+
+  // A handler collected before a cancel or a new deadline is stale
+  ASSERT_TRUE(t1->isCurrent(fired));
+  t1->cancel();
+  ASSERT_FALSE(t1->isCurrent(fired));
+  ASSERT_TRUE(t2->isCurrent(0));
+  t2->expiresAfter(30s);
+  ASSERT_FALSE(t2->isCurrent(0));
+  t2->cancel();
+}
+
+TEST_F(ConnectorTest, should_time_out_if_no_data_is_received_after_connecting)
+{
+  boost::asio::io_context::strand strand(m_context);
+  m_connector = make_unique<TestConnector>(strand, "127.0.0.1", m_port, 1s);
+  startServer();
+
+  m_connector->start(m_port);
+  runUntil(2s, [this]() -> bool { return m_connected && m_connector->isConnected(); });
+
+  auto line = read(1s);
+  ASSERT_EQ("* PING", line);
+
+  // No data at all, the receive timeout is armed when connected
+  m_context.run_for(1200ms);
+
+  ASSERT_TRUE(m_connector->m_disconnected);
+}
@@ -20,6 +20,7 @@
 // Keep this comment to keep gtest.h above. (clang-format off/on is not working here!)
 
 #include <chrono>
+#include <cmath>
 
 #include "observation/observation.hpp"
 #include "pipeline/pipeline_context.hpp"
@@ -41,8 +42,10 @@ public:
   DevicePtr findDevice(const std::string &) override { return nullptr; }
   DataItemPtr findDataItem(const std::string &device, const std::string &name) override
   {
+    m_lookups++;
     return m_dataItems[name];
   }
+  std::optional<uint64_t> deviceGeneration() const override { return m_generation; }
   void eachDataItem(EachDataItem fun) override {}
   void deliverObservation(observation::ObservationPtr obs) override {}
   void deliverAsset(AssetPtr) override {}
@@ -53,6 +56,8 @@ public:
   void sourceFailed(const std::string &id) override {}
 
   std::map<string, DataItemPtr> &m_dataItems;
+  std::optional<uint64_t> m_generation;
+  int m_lookups {0};
 };
 
 class DataItemMappingTest : public testing::Test
@@ -119,7 +124,7 @@ TEST_F(DataItemMappingTest, SimpleUnavailableEvent)
 {
   Properties props {{"id", "a"s}, {"type", "EXECUTION"s}, {"category", "EVENT"s}};
   auto di = makeDataItem(props);
-  auto ts = makeTimestamped({"a", "unavailable"s});
+  auto ts = makeTimestamped({"a", "unavailable"});
 
   auto observations = (*m_mapper)(ts);
   auto &r = *observations;
@@ -496,7 +501,7 @@ TEST_F(DataItemMappingTest, continue_after_conversion_error)
       {{"id", "b"s}, {"type", "POSITION"s}, {"category", "SAMPLE"s}, {"units", "MILLIMETER"s}});
   auto prog = makeDataItem({{"id", "c"s}, {"type", "PROGRAM"s}, {"category", "EVENT"s}});
 
-  auto ts = makeTimestamped({"a", "test"s, "b", "1.23"s, "c", "program"s});
+  auto ts = makeTimestamped({"a", "test", "b", "1.23", "c", "program"});
   auto observations = (*m_mapper)(ts);
   auto &r = *observations;
   ASSERT_EQ(typeid(Observations), typeid(r));
@@ -524,3 +529,204 @@ TEST_F(DataItemMappingTest, continue_after_conversion_error)
   ASSERT_TRUE(prog->isEvent());
   ASSERT_EQ("program", program->getValue<string>());
 }
+
+TEST_F(DataItemMappingTest, should_cache_data_item_lookups_until_the_devices_change)
+{
+  auto contract = static_cast<MockPipelineContract *>(m_context->m_contract.get());
+  contract->m_generation = 1;
+
+  auto exec = makeDataItem({{"id", "a"s}, {"type", "EXECUTION"s}, {"category", "EVENT"s}});
+
+  for (int i = 0; i < 3; i++)
+  {
+    auto observations = (*m_mapper)(makeTimestamped({"a", "READY", "x", "1"}));
+    auto oblist = observations->getValue<EntityList>();
+    ASSERT_EQ(1, oblist.size());
+    ASSERT_EQ(exec, dynamic_pointer_cast<Observation>(oblist.front())->getDataItem());
+  }
+  // Unknown keys are not cached, x and 1 are both looked up every time in version 2
+  ASSERT_EQ(7, contract->m_lookups);
+
+  // A device change rebuilds the table and picks up the new data item
+  m_dataItems.clear();
+  auto pos = makeDataItem({{"id", "a"s},
+                           {"type", "POSITION"s},
+                           {"category", "SAMPLE"s},
+                           {"units", "MILLIMETER"s}});
+  contract->m_generation = 2;
+
+  auto observations = (*m_mapper)(makeTimestamped({"a", "1.5", "x", "1"}));
+  auto oblist = observations->getValue<EntityList>();
+  ASSERT_EQ(1, oblist.size());
+  auto sample = dynamic_pointer_cast<Sample>(oblist.front());
+  ASSERT_TRUE(sample);
+  ASSERT_EQ(pos, sample->getDataItem());
+  ASSERT_EQ(1.5, sample->getValue<double>());
+  ASSERT_EQ(10, contract->m_lookups);
+}
+
+TEST_F(DataItemMappingTest, should_fall_back_to_generic_conversion_for_non_numeric_samples)
+{
+  auto pos = makeDataItem(
+      {{"id", "a"s}, {"type", "POSITION"s}, {"category", "SAMPLE"s}, {"units", "MILLIMETER"s}});
+  auto count = makeDataItem({{"id", "b"s},
+                             {"type", "PART_COUNT"s},
+                             {"category", "EVENT"s},
+                             {"ResetTrigger", "DAY"s}});
+
+  auto observations = (*m_mapper)(makeTimestamped({"a", " 2.5mm", "b", "10:DAY"}));
+  auto oblist = observations->getValue<EntityList>();
+  ASSERT_EQ(2, oblist.size());
+
+  auto it = oblist.begin();
+  auto sample = dynamic_pointer_cast<Sample>(*it++);
+  ASSERT_TRUE(sample);
+  ASSERT_EQ(2.5, sample->getValue<double>());
+
+  auto event = dynamic_pointer_cast<Event>(*it++);
+  ASSERT_TRUE(event);
+  ASSERT_EQ("10", event->getValue<string>());
+  ASSERT_EQ("DAY", event->get<string>("resetTriggered"));
+}
+
+TEST_F(DataItemMappingTest, should_convert_samples_the_same_as_the_generic_conversion)
+{
+  makeDataItem(
+      {{"id", "a"s}, {"type", "POSITION"s}, {"category", "SAMPLE"s}, {"units", "MILLIMETER"s}});
+
+  entity::Requirement req("VALUE", entity::DOUBLE, false);
+  for (int i = 0; i < 1000; i++)
+  {
+    auto v = to_string(i * 0.731);
+    entity::Value value {string(v)};
+    req.convertType(value);
+
+    ASSERT_EQ(get<double>(value), *parseDouble(v)) << v;
+
+    auto observations = (*m_mapper)(makeTimestamped({"a", v}));
+    auto oblist = observations->getValue<EntityList>();
+    ASSERT_EQ(get<double>(value), dynamic_pointer_cast<Sample>(oblist.front())->getValue<double>())
+        << v;
+  }
+}
+
+// Run with --gtest_also_run_disabled_tests
+TEST_F(DataItemMappingTest, DISABLED_benchmark_sample_conversion)
+{
+  makeDataItem(
+      {{"id", "a"s}, {"type", "POSITION"s}, {"category", "SAMPLE"s}, {"units", "MILLIMETER"s}});
+
+  vector<string> values;
+  for (int i = 0; i < 10000; i++)
+    values.push_back(to_string(i * 0.731));
+
+  // Generic conversion through the entity requirement
+  entity::Requirement req("VALUE", entity::DOUBLE, false);
+  double generic = 0.0;
+  auto t0 = chrono::steady_clock::now();
+  for (auto &v : values)
+  {
+    entity::Value value {string(v)};
+    req.convertType(value);
+    generic += get<double>(value);
+  }
+  auto t1 = chrono::steady_clock::now();
+
+  double fast = 0.0;
+  for (auto &v : values)
+    fast += *parseDouble(v);
+  auto t2 = chrono::steady_clock::now();
+
+  // The whole mapper using the fast path
+  double mapped = 0.0;
+  for (auto &v : values)
+  {
+    auto observations = (*m_mapper)(makeTimestamped({"a", v}));
+    auto oblist = observations->getValue<EntityList>();
+    mapped += dynamic_pointer_cast<Sample>(oblist.front())->getValue<double>();
+  }
+  auto t3 = chrono::steady_clock::now();
+
+  ASSERT_EQ(generic, fast);
+  ASSERT_EQ(generic, mapped);
+  cout << "generic conversion: " << chrono::duration_cast<chrono::microseconds>(t1 - t0).count()
+       << "us, fast conversion: " << chrono::duration_cast<chrono::microseconds>(t2 - t1).count()
+       << "us, mapping with fast path: "
+       << chrono::duration_cast<chrono::microseconds>(t3 - t2).count() << "us for "
+       << values.size() << " samples" << endl;
+}
+
+TEST_F(DataItemMappingTest, should_parse_timeseries_the_same_as_the_generic_conversion)
+{
+  makeDataItem({{"id", "a"s},
+                {"type", "DISPLACEMENT"s},
+                {"category", "SAMPLE"s},
+                {"units", "MILLIMETER"s},
+                {"representation", "TIME_SERIES"s}});
+
+  string values;
+  for (int i = 0; i < 1000; i++)
+  {
+    if (i > 0)
+      values += ' ';
+    values += format(sin(i * 0.01) * 0.25);
+  }
+
+  entity::Requirement req("VALUE", entity::VECTOR, false);
+  entity::Value value {string(values)};
+  req.convertType(value);
+  auto &generic = get<entity::Vector>(value);
+  ASSERT_EQ(1000, generic.size());
+
+  auto observations = (*m_mapper)(makeTimestamped({"a", "1000", "1000", values}));
+  auto oblist = observations->getValue<EntityList>();
+  auto series = dynamic_pointer_cast<Timeseries>(oblist.front());
+  ASSERT_TRUE(series);
+  ASSERT_EQ(generic, series->getValue<entity::Vector>());
+}
+
+// Run with --gtest_also_run_disabled_tests
+TEST_F(DataItemMappingTest, DISABLED_benchmark_timeseries_parsing)
+{
+  makeDataItem({{"id", "a"s},
+                {"type", "DISPLACEMENT"s},
+                {"category", "SAMPLE"s},
+                {"units", "MILLIMETER"s},
+                {"representation", "TIME_SERIES"s}});
+
+  // One second of a 1 kHz vibration signal per observation
+  string values;
+  for (int i = 0; i < 1000; i++)
+  {
+    if (i > 0)
+      values += ' ';
+    values += format(sin(i * 0.01) * 0.25);
+  }
+
+  constexpr int count = 100;
+  entity::Requirement req("VALUE", entity::VECTOR, false);
+  auto t0 = chrono::steady_clock::now();
+  for (int i = 0; i < count; i++)
+  {
+    entity::Value value {string(values)};
+    req.convertType(value);
+    ASSERT_EQ(1000, get<entity::Vector>(value).size());
+  }
+  auto t1 = chrono::steady_clock::now();
+
+  for (int i = 0; i < count; i++)
+  {
+    auto observations = (*m_mapper)(makeTimestamped({"a", "1000", "1000", values}));
+    auto oblist = observations->getValue<EntityList>();
+    auto series = dynamic_pointer_cast<Timeseries>(oblist.front());
+    ASSERT_TRUE(series);
+    ASSERT_EQ(1000, series->getValue<entity::Vector>().size());
+  }
+  auto t2 = chrono::steady_clock::now();
+
+  cout << "generic vector conversion: "
+       << chrono::duration_cast<chrono::microseconds>(t1 - t0).count()
+       << "us, mapping with fast path: "
+       << chrono::duration_cast<chrono::microseconds>(t2 - t1).count() << "us for " << count
+       << " timeseries of 1000 samples" << endl;
+}
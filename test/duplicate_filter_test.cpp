@@ -20,6 +20,7 @@
 // Keep this comment to keep gtest.h above. (clang-format off/on is not working here!)
 
 #include <chrono>
+#include <thread>
 
 #include "observation/observation.hpp"
 #include "pipeline/delta_filter.hpp"
@@ -194,3 +195,138 @@ TEST_F(DuplicateFilterTest, test_minimum_delta)
     ASSERT_EQ(1, list.size());
   }
 }
+
+TEST_F(DuplicateFilterTest, should_filter_duplicates_within_a_batch)
+{
+  makeDataItem({{"id", "a"s}, {"type", "EXECUTION"s}, {"category", "EVENT"s}});
+  makeDataItem({{"id", "c"s}, {"type", "EXECUTION"s}, {"category", "EVENT"s}});
+
+  auto filter = make_shared<DuplicateFilter>(m_context);
+  m_mapper->bind(filter);
+
+  auto os1 = observe({"a", "READY", "c", "READY", "a", "READY", "a", "ACTIVE"});
+  auto list1 = os1->getValue<EntityList>();
+  ASSERT_EQ(3, list1.size());
+
+  auto it = list1.begin();
+  ASSERT_EQ("a", dynamic_pointer_cast<Observation>(*it)->getDataItem()->getId());
+  ASSERT_EQ("READY", (*it++)->getValue<string>());
+  ASSERT_EQ("c", dynamic_pointer_cast<Observation>(*it)->getDataItem()->getId());
+  ASSERT_EQ("READY", (*it++)->getValue<string>());
+  ASSERT_EQ("a", dynamic_pointer_cast<Observation>(*it)->getDataItem()->getId());
+  ASSERT_EQ("ACTIVE", (*it++)->getValue<string>());
+
+  auto os2 = observe({"a", "ACTIVE", "c", "ACTIVE"});
+  auto list2 = os2->getValue<EntityList>();
+  ASSERT_EQ(1, list2.size());
+}
+
+TEST_F(DuplicateFilterTest, should_filter_minimum_delta_within_a_batch)
+{
+  ErrorList errors;
+  auto f =
+      Filter::getFactory()->create("Filter", {{"type", "MINIMUM_DELTA"s}, {"VALUE", 1.0}}, errors);
+  EntityList list {f};
+  auto filters = DataItem::getFactory()->factoryFor("DataItem")->create("Filters", list, errors);
+
+  makeDataItem({{"id", "a"s},
+                {"type", "POSITION"s},
+                {"category", "SAMPLE"s},
+                {"units", "MILLIMETER"s},
+                {"Filters", filters}});
+
+  auto filter = make_shared<DeltaFilter>(m_context);
+  m_mapper->bind(filter);
+
+  auto os1 = observe({"a", "1.5", "a", "1.6", "a", "2.7", "a", "2.8", "a", "4.0"});
+  auto list1 = os1->getValue<EntityList>();
+  ASSERT_EQ(3, list1.size());
+
+  auto it = list1.begin();
+  ASSERT_EQ(1.5, (*it++)->getValue<double>());
+  ASSERT_EQ(2.7, (*it++)->getValue<double>());
+  ASSERT_EQ(4.0, (*it++)->getValue<double>());
+}
+
+TEST_F(DuplicateFilterTest, should_share_state_between_pipelines_without_a_global_lock)
+{
+  constexpr int ThreadCount = 4;
+  constexpr int Iterations = 1000;
+
+  vector<DataItemPtr> items;
+  for (int i = 0; i < ThreadCount * 2; i++)
+  {
+    items.emplace_back(makeDataItem(
+        {{"id", "d" + to_string(i)}, {"type", "EXECUTION"s}, {"category", "EVENT"s}}));
+  }
+
+  // Each filter stands in for an adapter pipeline sharing the same context.
+  vector<shared_ptr<DuplicateFilter>> filters;
+  for (int t = 0; t < ThreadCount; t++)
+  {
+    auto filter = make_shared<DuplicateFilter>(m_context);
+    filter->bind(make_shared<NullTransform>(TypeGuard<Observation>(RUN)));
+    filters.emplace_back(filter);
+  }
+
+  vector<int> delivered(ThreadCount, 0);
+  vector<thread> threads;
+  for (int t = 0; t < ThreadCount; t++)
+  {
+    threads.emplace_back([t, &items, &filters, &delivered]() {
+      auto &filter = filters[t];
+      for (int i = 0; i < Iterations; i++)
+      {
+        for (int d = t * 2; d < t * 2 + 2; d++)
+        {
+          ErrorList errors;
+          auto obs = Observation::make(items[d], {{"VALUE", ((i / 2) % 2) ? "A"s : "B"s}},
+                                       chrono::system_clock::now(), errors);
+          if ((*filter)(obs))
+            delivered[t]++;
+        }
+      }
+    });
+  }
+
+  for (auto &th : threads)
+    th.join();
+
+  for (int t = 0; t < ThreadCount; t++)
+    ASSERT_EQ(Iterations, delivered[t]);
+
+  auto state = m_context->getSharedState<DuplicateFilter::State>("DuplicateFilter");
+  size_t count = 0;
+  for (auto &partition : state->m_partitions)
+    count += partition.m_values.size();
+  ASSERT_EQ(ThreadCount * 2, count);
+}
+
+TEST_F(DuplicateFilterTest, should_only_drop_the_failing_observation_of_a_batch)
+{
+  makeDataItem({{"id", "a"s}, {"type", "EXECUTION"s}, {"category", "EVENT"s}});
+  makeDataItem({{"id", "c"s}, {"type", "EXECUTION"s}, {"category", "EVENT"s}});
+
+  struct Rejecting : public Transform
+  {
+    Rejecting() : Transform("Rejecting") { m_guard = TypeGuard<Observation>(RUN); }
+    const EntityPtr operator()(const EntityPtr entity) override
+    {
+      if (entity->getValue<string>() == "STOPPED")
+        throw EntityError("Rejected");
+      return entity;
+    }
+  };
+
+  auto filter = make_shared<DuplicateFilter>(m_context);
+  m_mapper->bind(filter);
+  filter->bind(make_shared<Rejecting>());
+
+  auto os = observe({"a", "READY", "c", "STOPPED", "a", "ACTIVE"});
+  auto list = os->getValue<EntityList>();
+  ASSERT_EQ(2, list.size());
+
+  auto it = list.begin();
+  ASSERT_EQ("READY", (*it++)->getValue<string>());
+  ASSERT_EQ("ACTIVE", (*it++)->getValue<string>());
+}
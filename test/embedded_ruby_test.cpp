@@ -331,7 +331,7 @@ $source.pipeline.splice_after('Start', $trans)
 )");
 
     auto tokens = make_shared<pipeline::Tokens>();
-    tokens->m_tokens = {"Xact"s, "100.0"s};
+    tokens->m_tokens = {"Xact", "100.0"};
 
     loopback->getPipeline()->run(tokens);
 
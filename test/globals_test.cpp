@@ -19,7 +19,9 @@
 #include <gtest/gtest.h>
 // Keep this comment to keep gtest.h above. (clang-format off/on is not working here!)
 
+#include <cmath>
 #include <date/date.h>
+#include <random>
 #include <thread>
 
 #include "utilities.hpp"
@@ -206,3 +208,206 @@ TEST(GlobalsTest, ParseTimeMilli)
 }
 
 TEST(GlobalsTest, Int64ToString) { ASSERT_EQ((string) "8805345009", to_string(8805345009ULL)); }
+
+static optional<Timestamp> streamParse(const string &text)
+{
+  Timestamp ts;
+  istringstream in(text);
+  in >> std::setw(6) >> date::parse("%FT%T", ts);
+  if (!in.good())
+    return nullopt;
+  return ts;
+}
+
+TEST(GlobalsTest, should_parse_timestamps_the_same_as_date_parse)
+{
+  mt19937 gen(20221018);
+  uniform_int_distribution<int> year(1970, 2099), month(1, 12), day(1, 28), hour(0, 23),
+      minute(0, 59), second(0, 59), digits(0, 9), digit(0, 9);
+
+  char buffer[64];
+  for (int i = 0; i < 10000; i++)
+  {
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d", year(gen), month(gen),
+             day(gen), hour(gen), minute(gen), second(gen));
+    string text(buffer);
+    auto n = digits(gen);
+    if (n > 0)
+    {
+      text += '.';
+      for (int d = 0; d < n; d++)
+        text += char('0' + digit(gen));
+    }
+    text += 'Z';
+
+    auto expected = streamParse(text);
+    ASSERT_TRUE(expected) << text;
+    auto actual = parseTimestamp(text);
+    ASSERT_TRUE(actual) << text;
+    ASSERT_EQ(*expected, *actual) << text;
+  }
+}
+
+TEST(GlobalsTest, should_reject_invalid_timestamps)
+{
+  for (auto text : {"2021-13-01T00:00:00Z", "2021-02-30T00:00:00Z", "2021-01-01T24:00:00Z",
+                    "2021-01-01T00:60:00Z", "2021-01-01T00:00:60Z", "2021-01-01T00:00Z",
+                    "2021-0a-01T00:00:00Z", "20210101T000000Z", "hello", ""})
+  {
+    ASSERT_FALSE(parseTimestamp(text)) << text;
+  }
+}
+
+TEST(GlobalsTest, should_parse_timestamps_with_offsets_and_dates)
+{
+  using namespace date;
+  using namespace std::chrono;
+
+  auto utc = parseTimestamp("2021-01-19T12:00:00.5Z");
+  ASSERT_TRUE(utc);
+  ASSERT_EQ(sys_days(2021_y / January / 19) + 12h + 500ms, *utc);
+
+  ASSERT_EQ(*utc, *parseTimestamp("2021-01-19T14:00:00.5+02:00"));
+  ASSERT_EQ(*utc, *parseTimestamp("2021-01-19T06:30:00.5-0530"));
+  ASSERT_EQ(*utc, *parseTimestamp("2021-01-19T12:00:00.5"));
+
+  // Only the date
+  ASSERT_EQ(Timestamp(sys_days(2021_y / January / 19)), *parseTimestamp("2021-01-19"));
+
+  // Extra precision is ignored
+  ASSERT_EQ(*parseTimestamp("2021-01-19T12:00:00.123456789Z"),
+            *parseTimestamp("2021-01-19T12:00:00.1234567891234Z"));
+
+  // The cached date must not leak into the next timestamp
+  ASSERT_EQ(sys_days(2021_y / January / 20) + 1s, *parseTimestamp("2021-01-20T00:00:01Z"));
+  ASSERT_EQ(sys_days(2021_y / January / 19) + 1s, *parseTimestamp("2021-01-19T00:00:01Z"));
+}
+
+static string streamFormat(const Timestamp &ts)
+{
+  string time = date::format("%FT%T", date::floor<Microseconds>(ts));
+  auto pos = time.find_last_not_of("0");
+  if (pos != string::npos)
+  {
+    if (time[pos] != '.')
+      pos++;
+    time.erase(pos);
+  }
+  time.append("Z");
+  return time;
+}
+
+TEST(GlobalsTest, should_format_timestamps_the_same_as_date_format)
+{
+  mt19937_64 gen(20221018);
+  uniform_int_distribution<int64_t> micros(0, 4102444800000000LL), offset(0, 2000000);
+
+  Timestamp ts;
+  for (int i = 0; i < 10000; i++)
+  {
+    // Mix of new seconds and timestamps within the cached second
+    if (i % 4 == 0)
+      ts = Timestamp(Microseconds(micros(gen)));
+    else
+      ts += Microseconds(offset(gen));
+    if (i % 7 == 0)
+      ts = date::floor<chrono::seconds>(ts);
+    else if (i % 5 == 0)
+      ts = date::floor<chrono::milliseconds>(ts);
+
+    ASSERT_EQ(streamFormat(ts), format(ts));
+  }
+
+  auto now = chrono::system_clock::now();
+  ASSERT_EQ(date::format("%Y-%m-%dT%H:%M:%SZ", date::floor<chrono::seconds>(now)),
+            getCurrentTime(now, GMT));
+  ASSERT_EQ(date::format("%Y-%m-%dT%H:%M:%SZ", date::floor<chrono::microseconds>(now)),
+            getCurrentTime(now, GMT_UV_SEC));
+}
+
+// The formats are compared above, run with --gtest_also_run_disabled_tests for the timings
+TEST(GlobalsTest, DISABLED_benchmark_timestamp_formatting)
+{
+  auto start = chrono::system_clock::now();
+  vector<Timestamp> stamps;
+  for (int i = 0; i < 10000; i++)
+    stamps.push_back(start + Microseconds(i * 37));
+
+  size_t total = 0;
+  auto t0 = chrono::steady_clock::now();
+  for (auto &ts : stamps)
+    total += streamFormat(ts).size();
+  auto t1 = chrono::steady_clock::now();
+  for (auto &ts : stamps)
+    total -= format(ts).size();
+  auto t2 = chrono::steady_clock::now();
+
+  ASSERT_EQ(0, total);
+  cout << "date::format: " << chrono::duration_cast<chrono::microseconds>(t1 - t0).count()
+       << "us, cached prefix: " << chrono::duration_cast<chrono::microseconds>(t2 - t1).count()
+       << "us for " << stamps.size() << " timestamps" << endl;
+}
+
+TEST(GlobalsTest, should_parse_numbers_the_same_as_strtod)
+{
+  mt19937_64 gen(20221018);
+  uniform_real_distribution<double> real(-1.0e6, 1.0e6);
+  uniform_int_distribution<int64_t> integer(numeric_limits<int64_t>::min(),
+                                            numeric_limits<int64_t>::max());
+
+  char buffer[64];
+  for (int i = 0; i < 10000; i++)
+  {
+    snprintf(buffer, sizeof(buffer), "%.*g", int(i % 17) + 1, real(gen));
+    auto d = parseDouble(buffer);
+    ASSERT_TRUE(d) << buffer;
+    ASSERT_EQ(strtod(buffer, nullptr), *d) << buffer;
+
+    snprintf(buffer, sizeof(buffer), "%lld", (long long)integer(gen));
+    auto l = parseInteger(buffer);
+    ASSERT_TRUE(l) << buffer;
+    ASSERT_EQ(strtoll(buffer, nullptr, 10), *l) << buffer;
+  }
+
+  // Anything that is not entirely a number is left to the generic conversion
+  for (auto text : {"", " 1.5", "1.5 ", "1.5x", "x", "1.5:2", "1.2.3"})
+  {
+    ASSERT_FALSE(parseDouble(text)) << text;
+    ASSERT_FALSE(parseInteger(text)) << text;
+  }
+  ASSERT_FALSE(parseInteger("1.5"));
+  ASSERT_FALSE(parseInteger("99999999999999999999"));
+}
+
+TEST(GlobalsTest, should_format_doubles_the_same_as_a_stream)
+{
+  mt19937_64 gen(20221018);
+  uniform_real_distribution<double> real(-1.0e6, 1.0e6);
+  uniform_int_distribution<int> exponent(-40, 40);
+
+  for (int i = 0; i < 10000; i++)
+  {
+    auto value = ldexp(real(gen), exponent(gen));
+    stringstream s;
+    s << formatted(value);
+    ASSERT_EQ(s.str(), format(value));
+  }
+
+  ASSERT_EQ("0", format(0.0));
+  ASSERT_EQ("1e+16", format(1.0e16));
+  ASSERT_EQ("0.333333333333333", format(1.0 / 3.0));
+}
+
+TEST(GlobalsTest, should_parse_vectors_of_doubles)
+{
+  vector<double> values;
+  ASSERT_TRUE(parseVector("1.5 -2  3e2\t4", values));
+  ASSERT_EQ((vector<double> {1.5, -2.0, 300.0, 4.0}), values);
+
+  // Values that need the lenient conversion are rejected and leave the vector as it was
+  for (auto text : {"", "   ", "1.5 x", "1,2", "1.5mm 2"})
+  {
+    ASSERT_FALSE(parseVector(text, values)) << text;
+    ASSERT_EQ(4, values.size()) << text;
+  }
+}
@@ -703,3 +703,16 @@ TEST_F(RestServiceTest, failure_when_tls_only)
 
   EXPECT_EQ((unsigned)boost::beast::http::status::unauthorized, m_client->m_status);
 }
+
+TEST_F(RestServiceTest, should_evict_the_oldest_clients_when_the_rate_limiter_is_full)
+{
+  RateLimiter limiter(0.001, 1.0, 8);
+
+  for (int i = 0; i < 20; i++)
+    ASSERT_TRUE(limiter.admit("client" + to_string(i)));
+  ASSERT_GE(8u, limiter.getClientCount());
+
+  // The most recent client is still limited, the oldest has been forgotten
+  ASSERT_FALSE(limiter.admit("client19"));
+  ASSERT_TRUE(limiter.admit("client0"));
+}
@@ -0,0 +1,147 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+// Ensure that gtest is the first header otherwise Windows raises an error
+#include <gtest/gtest.h>
+// Keep this comment to keep gtest.h above. (clang-format off/on is not working here!)
+
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "buffer/ingest_queue.hpp"
+#include "device_model/data_item/data_item.hpp"
+
+using namespace std;
+using namespace std::literals;
+using namespace mtconnect;
+using namespace mtconnect::buffer;
+using namespace mtconnect::observation;
+using namespace mtconnect::entity;
+using namespace mtconnect::device_model::data_item;
+
+class IngestQueueTest : public testing::Test
+{
+protected:
+  DataItemPtr makeDataItem(const string &id)
+  {
+    ErrorList errors;
+    auto di = DataItem::make({{"id", id}, {"type", "EXECUTION"s}, {"category", "EVENT"s}}, errors);
+    EXPECT_EQ(0, errors.size());
+    return di;
+  }
+
+  ObservationPtr makeObservation(const DataItemPtr &di, int value)
+  {
+    ErrorList errors;
+    return Observation::make(di, {{"VALUE", to_string(value)}}, chrono::system_clock::now(),
+                             errors);
+  }
+};
+
+TEST_F(IngestQueueTest, should_preserve_producer_order_with_concurrent_producers)
+{
+  constexpr int Producers = 4;
+  constexpr int Count = 2000;
+
+  vector<ObservationPtr> delivered;
+  int batches = 0;
+  IngestQueue queue(
+      [&](ObservationList &batch) {
+        batches++;
+        delivered.insert(delivered.end(), batch.begin(), batch.end());
+      },
+      64);
+
+  vector<DataItemPtr> items;
+  for (int p = 0; p < Producers; p++)
+    items.emplace_back(makeDataItem("d" + to_string(p)));
+
+  vector<thread> threads;
+  for (int p = 0; p < Producers; p++)
+  {
+    threads.emplace_back([&, p]() {
+      for (int i = 0; i < Count; i++)
+        queue.push(makeObservation(items[p], i));
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+
+  ASSERT_EQ(0, queue.size());
+  ASSERT_EQ(Producers * Count, delivered.size());
+  ASSERT_GE(Producers * Count, batches);
+
+  map<string, int> last;
+  for (auto &o : delivered)
+  {
+    auto &id = o->getDataItem()->getId();
+    auto value = stoi(o->getValue<string>());
+    auto it = last.find(id);
+    if (it != last.end())
+    {
+      ASSERT_EQ(it->second + 1, value) << "Out of order for " << id;
+      it->second = value;
+    }
+    else
+    {
+      ASSERT_EQ(0, value);
+      last[id] = value;
+    }
+  }
+}
+
+TEST_F(IngestQueueTest, should_deliver_observations_pushed_while_draining)
+{
+  auto di = makeDataItem("a");
+
+  vector<ObservationPtr> delivered;
+  IngestQueue *self = nullptr;
+  IngestQueue queue([&](ObservationList &batch) {
+    for (auto &o : batch)
+    {
+      delivered.emplace_back(o);
+      auto value = stoi(o->getValue<string>());
+      if (value < 3)
+        self->push(makeObservation(di, value + 1));
+    }
+  });
+  self = &queue;
+
+  queue.push(makeObservation(di, 0));
+
+  ASSERT_EQ(0, queue.size());
+  ASSERT_EQ(4, delivered.size());
+  for (int i = 0; i < 4; i++)
+    ASSERT_EQ(to_string(i), delivered[i]->getValue<string>());
+}
+
+TEST_F(IngestQueueTest, should_deliver_a_list_as_a_single_batch)
+{
+  auto di = makeDataItem("a");
+
+  vector<size_t> batches;
+  IngestQueue queue([&](ObservationList &batch) { batches.push_back(batch.size()); });
+
+  ObservationList list;
+  for (int i = 0; i < 10; i++)
+    list.emplace_back(makeObservation(di, i));
+  queue.push(list);
+
+  ASSERT_EQ(1, batches.size());
+  ASSERT_EQ(10, batches[0]);
+}
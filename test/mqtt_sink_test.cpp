@@ -182,6 +182,33 @@ TEST_F(MqttSinkTest, mqtt_sink_should_be_loaded_by_agent)
   ASSERT_TRUE(service);
 }
 
+TEST_F(MqttSinkTest, mqtt_sink_should_publish_queue_metrics_on_the_agent_device)
+{
+  createAgent();
+  auto agent = m_agentTestHelper->getAgent();
+  auto service = m_agentTestHelper->getMqttService();
+  auto &queue = service->getQueue();
+  ASSERT_TRUE(queue);
+
+  m_agentTestHelper->m_adapter->processData("2021-02-01T12:00:00Z|line|204");
+  m_agentTestHelper->m_ioContext.run_for(100ms);
+
+  agent->publishSinkMetrics();
+  m_agentTestHelper->m_ioContext.run_for(100ms);
+
+  auto value = [agent](const string &id) {
+    auto obs = agent->getLatest(id);
+    EXPECT_TRUE(obs) << id;
+    return obs ? obs->getValue<double>() : -1.0;
+  };
+
+  ASSERT_LT(0.0, value("MqttService_queue_high_water"));
+  ASSERT_EQ(double(queue->getHighWater()), value("MqttService_queue_high_water"));
+  ASSERT_EQ(0.0, value("MqttService_queue_dropped"));
+  ASSERT_EQ(0.0, value("MqttService_queue_coalesced"));
+  ASSERT_LE(0.0, value("MqttService_queue_depth"));
+}
+
 TEST_F(MqttSinkTest, mqtt_sink_should_connect_to_broker)
 {
   ConfigOptions options;
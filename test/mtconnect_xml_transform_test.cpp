@@ -44,7 +44,10 @@ public:
     return m_device->getDeviceDataItem(name);
   }
   void eachDataItem(EachDataItem fun) override {}
-  void deliverObservation(observation::ObservationPtr obs) override {}
+  void deliverObservation(observation::ObservationPtr obs) override
+  {
+    m_observations.push_back(obs);
+  }
   void deliverAsset(AssetPtr) override {}
   void deliverDevice(DevicePtr) override {}
   void deliverAssetCommand(entity::EntityPtr) override {}
@@ -53,6 +56,7 @@ public:
   void sourceFailed(const std::string &id) override {}
 
   DevicePtr m_device;
+  std::vector<ObservationPtr> m_observations;
 };
 
 class MTConnectXmlTransformTest : public testing::Test
@@ -146,3 +150,42 @@ TEST_F(MTConnectXmlTransformTest, should_throw_when_instances_change)
   ASSERT_EQ(1649989201, m_feedback.m_instanceId);
   ASSERT_EQ(4992049, m_feedback.m_next);
 }
+
+TEST_F(MTConnectXmlTransformTest, should_report_how_far_behind_the_upstream_agent_it_is)
+{
+  auto contract = static_cast<MockPipelineContract *>(m_context->m_contract.get());
+  m_xform = make_shared<MTConnectXmlTransform>(m_context, m_feedback, nullopt, "cl3"s);
+  m_xform->bind(make_shared<NullTransform>(TypeGuard<Entity>(RUN)));
+
+  auto document = [](const string &next, const string &last) {
+    return R"(<?xml version="1.0" encoding="UTF-8"?>
+<MTConnectStreams xmlns:m="urn:mtconnect.org:MTConnectStreams:1.7" xmlns="urn:mtconnect.org:MTConnectStreams:1.7">
+  <Header creationTime="2022-04-21T05:54:56Z" sender="IntelAgent" instanceId="1649989201" version="2.0.0.1" bufferSize="131072" nextSequence=")" +
+           next + R"(" firstSequence="1" lastSequence=")" + last + R"("/>
+    <Streams/>
+</MTConnectStreams>
+)";
+  };
+
+  auto entity = make_shared<Entity>(
+      "Data", Properties {{"VALUE", document("1001", "4000")}, {"source", "adapter"s}});
+  (*m_xform)(entity);
+
+  ASSERT_EQ(1001, m_feedback.m_next);
+  ASSERT_EQ(4000, m_feedback.m_last);
+  ASSERT_EQ(3000, m_feedback.lag());
+  ASSERT_EQ(1, contract->m_observations.size());
+  ASSERT_EQ(3000.0, contract->m_observations.back()->getValue<double>());
+
+  // The lag is only reported when it changes
+  (*m_xform)(entity);
+  ASSERT_EQ(1, contract->m_observations.size());
+
+  entity = make_shared<Entity>(
+      "Data", Properties {{"VALUE", document("4001", "4000")}, {"source", "adapter"s}});
+  (*m_xform)(entity);
+
+  ASSERT_EQ(0, m_feedback.lag());
+  ASSERT_EQ(2, contract->m_observations.size());
+  ASSERT_EQ(0.0, contract->m_observations.back()->getValue<double>());
+}
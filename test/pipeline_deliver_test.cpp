@@ -114,3 +114,101 @@ TEST_F(PipelineDeliverTest, filter_upcase)
   auto obs2 = rest->getFromBuffer(seq + 1);
   ASSERT_EQ(101.0, obs2->getValue<double>());
 }
+
+TEST_F(PipelineDeliverTest, should_memoize_type_guards_but_not_lambda_guards)
+{
+  Guard typeGuard = TypeGuard<Sample>(RUN) || TypeGuard<Observation>(SKIP);
+  ASSERT_TRUE(typeGuard.isCacheable());
+  ASSERT_FALSE(typeGuard.usesName());
+
+  Guard nameGuard = EntityNameGuard("Tokens", RUN);
+  ASSERT_TRUE(nameGuard.isCacheable());
+  ASSERT_TRUE(nameGuard.usesName());
+
+  Guard lambdaGuard =
+      LambdaGuard<Observation, TypeGuard<Event>>([](const Observation &) { return true; }, RUN) ||
+      TypeGuard<Observation>(SKIP);
+  ASSERT_FALSE(lambdaGuard.isCacheable());
+
+  Guard alternative = TypeGuard<Sample>(RUN) || [](const entity::EntityPtr) { return SKIP; };
+  ASSERT_FALSE(alternative.isCacheable());
+}
+
+TEST_F(PipelineDeliverTest, should_deliver_the_same_observations_with_and_without_guard_cache)
+{
+  ConfigOptions options {{configuration::FilterDuplicates, true}};
+  m_agentTestHelper->addAdapter(options);
+  auto rest = m_agentTestHelper->getRestService();
+
+  auto run = [&](bool cache, int offset) {
+    Guard::enableCache(cache);
+    for (int i = offset; i < offset + 20; i++)
+    {
+      auto v = to_string(i);
+      m_agentTestHelper->m_adapter->processData("2021-01-22T12:33:45.123Z|Xpos|" + v +
+                                                "|Xload|" + v + "|ptemp|" + v);
+    }
+  };
+
+  auto seq = rest->getSequence();
+  run(false, 0);
+  ASSERT_EQ(seq + 60, rest->getSequence());
+
+  // Duplicates are filtered the same way either way
+  seq = rest->getSequence();
+  run(true, 19);
+  ASSERT_EQ(seq + 57, rest->getSequence());
+
+  Guard::enableCache(true);
+}
+
+// Compares the throughput of a full SHDR pipeline, from tokenizing to delivery into the
+// buffer, with and without memoized guards. The duplicate filter's LambdaGuard is evaluated
+// in both runs. Run with --gtest_also_run_disabled_tests.
+TEST_F(PipelineDeliverTest, DISABLED_benchmark_guard_cache)
+{
+  ConfigOptions options {{configuration::FilterDuplicates, true}};
+  m_agentTestHelper->addAdapter(options);
+  auto rest = m_agentTestHelper->getRestService();
+
+  int value = 0;
+  auto run = [&](bool cache, int lines, chrono::nanoseconds &time, uint64_t &observations) {
+    Guard::enableCache(cache);
+    auto seq = rest->getSequence();
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < lines; i++)
+    {
+      auto v = to_string(value++);
+      m_agentTestHelper->m_adapter->processData("2021-01-22T12:33:45.123Z|Xpos|" + v +
+                                                "|Xload|" + v + "|ptemp|" + v);
+    }
+    time += chrono::steady_clock::now() - start;
+    observations += rest->getSequence() - seq;
+  };
+
+  // Warm up both paths, then alternate so neither run gets a warmer cache
+  chrono::nanoseconds uncached {0}, cached {0}, ignore {0};
+  uint64_t uncachedCount {0}, cachedCount {0}, ignoreCount {0};
+  run(false, 1000, ignore, ignoreCount);
+  run(true, 1000, ignore, ignoreCount);
+  for (int i = 0; i < 10; i++)
+  {
+    run(false, 10000, uncached, uncachedCount);
+    run(true, 10000, cached, cachedCount);
+  }
+  Guard::enableCache(true);
+
+  ASSERT_EQ(300000, uncachedCount);
+  ASSERT_EQ(300000, cachedCount);
+
+  auto perObservation = [](chrono::nanoseconds time, uint64_t count) {
+    return double(time.count()) / double(count);
+  };
+  cout << "Guard evaluation: " << uncachedCount << " observations in "
+       << chrono::duration_cast<chrono::milliseconds>(uncached).count() << "ms, "
+       << perObservation(uncached, uncachedCount) << "ns/observation" << endl;
+  cout << "Memoized guards:  " << cachedCount << " observations in "
+       << chrono::duration_cast<chrono::milliseconds>(cached).count() << "ms, "
+       << perObservation(cached, cachedCount) << "ns/observation" << endl;
+  cout << "Speedup: " << double(uncached.count()) / double(cached.count()) << "x" << endl;
+}
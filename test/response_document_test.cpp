@@ -21,6 +21,8 @@
 
 #include <chrono>
 
+#include <nlohmann/json.hpp>
+
 #include "agent.hpp"
 #include "entity/entity.hpp"
 #include "pipeline/mtconnect_xml_transform.hpp"
@@ -396,3 +398,173 @@ TEST_F(ResponseDocumentTest, should_parse_legacy_error)
   ASSERT_EQ("OUT_OF_RANGE", error.m_code);
   ASSERT_EQ("'at' must be greater than 4871368", error.m_message);
 }
+
+TEST_F(ResponseDocumentTest, should_stream_observations_from_large_documents)
+{
+  string data {R"(<?xml version="1.0" encoding="UTF-8"?>
+<MTConnectStreams xmlns:m="urn:mtconnect.org:MTConnectStreams:1.8"
+    xmlns="urn:mtconnect.org:MTConnectStreams:1.8">
+    <Header creationTime="2022-04-22T04:06:21Z" sender="IntelAgent" instanceId="1649989201" version="2.0.0.1" bufferSize="131072" nextSequence="5741581" firstSequence="5610509" lastSequence="5741580"/>
+    <Streams>
+        <DeviceStream name="LinuxCNC" uuid="000">
+            <ComponentStream componentId="c" component="Rotary">
+                <Samples>
+)"};
+
+  for (int i = 0; i < 1000; i++)
+  {
+    data.append("<RotaryVelocity sequence=\"")
+        .append(to_string(i + 1))
+        .append("\" timestamp=\"2022-04-22T04:06:21Z\" dataItemId=\"c1\">")
+        .append(to_string(i))
+        .append(i % 100 == 0 ? "<Extra>5</Extra>" : "")
+        .append("</RotaryVelocity>\n");
+  }
+  data.append(R"(                    <Unknown sequence="2000" timestamp="2022-04-22T04:06:21Z" dataItemId="xxx">1</Unknown>
+                </Samples>
+            </ComponentStream>
+            <Other><Samples><RotaryVelocity dataItemId="c1">2</RotaryVelocity></Samples></Other>
+        </DeviceStream>
+    </Streams>
+</MTConnectStreams>
+)");
+
+  m_doc.emplace();
+  ASSERT_TRUE(ResponseDocument::parse(data, *m_doc, m_context));
+
+  ASSERT_EQ(5741581, m_doc->m_next);
+  ASSERT_EQ(1649989201, m_doc->m_instanceId);
+  ASSERT_EQ(1000, m_doc->m_entities.size());
+
+  int i = 0;
+  for (auto &ent : m_doc->m_entities)
+  {
+    ASSERT_EQ("RotaryVelocity", ent->getName());
+    ASSERT_EQ("c1", ent->get<string>("dataItemId"));
+    ASSERT_EQ(double(i++), ent->getValue<double>());
+  }
+}
+
+TEST_F(ResponseDocumentTest, should_not_return_observations_from_truncated_documents)
+{
+  string data {R"(<?xml version="1.0" encoding="UTF-8"?>
+<MTConnectStreams xmlns="urn:mtconnect.org:MTConnectStreams:1.8">
+    <Header creationTime="2022-04-22T04:06:21Z" sender="IntelAgent" instanceId="1649989201" version="2.0.0.1" bufferSize="131072" nextSequence="5741581" firstSequence="5610509" lastSequence="5741580"/>
+    <Streams>
+        <DeviceStream name="LinuxCNC" uuid="000">
+            <ComponentStream componentId="c" component="Rotary">
+                <Samples>
+                    <RotaryVelocity sequence="5741553" timestamp="2022-04-22T04:06:21Z" dataItemId="c1">1556.33</RotaryVelocity>
+                    <RotaryVelocity sequence="5741554" timestamp="2022-04-22T04:06:21Z" dataItemId="c1">15)"};
+
+  m_doc.emplace();
+  ASSERT_FALSE(ResponseDocument::parse(data, *m_doc, m_context));
+  ASSERT_EQ(0, m_doc->m_entities.size());
+}
+
+TEST_F(ResponseDocumentTest, should_parse_json_observations)
+{
+  string data {R"({"MTConnectStreams":{"Header":{"bufferSize":131072,"creationTime":"2022-04-22T04:06:21Z",
+"firstSequence":5610509,"instanceId":1649989201,"lastSequence":5741580,"nextSequence":5741581,
+"sender":"IntelAgent","version":"2.0.0.1"},
+"Streams":[{"DeviceStream":{"ComponentStreams":[
+  {"ComponentStream":{"component":"Device","componentId":"d",
+    "Events":[{"AssetChanged":{"assetType":"CuttingTool","dataItemId":"d_asset_chg","sequence":5741550,"timestamp":"2022-04-22T04:06:21Z","value":"TOOLABC"}},
+              {"AssetRemoved":{"assetType":"CuttingTool","dataItemId":"d_asset_rem","sequence":5741551,"timestamp":"2022-04-22T04:06:21Z","value":"TOOLDEF"}}]}},
+  {"ComponentStream":{"component":"Path","componentId":"path1",
+    "Events":[{"ControllerMode":{"dataItemId":"px","name":"mode","sequence":5741552,"timestamp":"2022-04-22T04:06:21Z","value":"AUTOMATIC"}}]}},
+  {"ComponentStream":{"component":"Rotary","componentId":"c",
+    "Samples":[{"RotaryVelocity":{"dataItemId":"c1","sequence":5741553,"timestamp":"2022-04-22T04:06:21Z","value":1556.33}}]}}],
+ "name":"LinuxCNC","uuid":"000"}}],"jsonVersion":1}})"};
+
+  m_doc.emplace();
+  ASSERT_TRUE(ResponseDocument::parse(data, *m_doc, m_context));
+
+  ASSERT_EQ(5741581, m_doc->m_next);
+  ASSERT_EQ(1649989201, m_doc->m_instanceId);
+
+  ASSERT_EQ(3, m_doc->m_entities.size());
+  auto ent = m_doc->m_entities.begin();
+
+  ASSERT_EQ("AssetCommand", (*ent)->getName());
+  ASSERT_EQ("RemoveAsset", (*ent)->getValue<string>());
+  ASSERT_EQ("TOOLDEF", (*ent)->get<string>("assetId"));
+
+  ent++;
+  ASSERT_EQ("ControllerMode", (*ent)->getName());
+  ASSERT_EQ("AUTOMATIC", (*ent)->getValue<string>());
+  ASSERT_EQ("p2", (*ent)->get<string>("dataItemId"));
+
+  ent++;
+  ASSERT_EQ("RotaryVelocity", (*ent)->getName());
+  ASSERT_EQ(1556.33, (*ent)->getValue<double>());
+  ASSERT_EQ("c1", (*ent)->get<string>("dataItemId"));
+
+  ASSERT_EQ(1, m_doc->m_assetEvents.size());
+  auto aent = m_doc->m_assetEvents.begin();
+
+  ASSERT_EQ("AssetChanged", (*aent)->getName());
+  ASSERT_EQ("TOOLABC", (*aent)->getValue<string>());
+}
+
+TEST_F(ResponseDocumentTest, should_parse_json_version_2_and_cbor_data_sets)
+{
+  string data {R"({"MTConnectStreams":{"Header":{"instanceId":1649989201,"nextSequence":5741581},
+"Streams":{"DeviceStream":{"ComponentStream":{"component":"Path","componentId":"path1",
+  "Events":{"VariableDataSet":[
+    {"count":0,"dataItemId":"v1","name":"vars","sequence":5741552,"timestamp":"2022-04-22T04:06:21Z","value":"UNAVAILABLE"},
+    {"count":4,"dataItemId":"v1","name":"vars","sequence":5741553,"timestamp":"2022-04-22T04:06:21Z",
+     "value":{"X100":66,"X101":"ABC","X102":44.6,"X103":{"removed":true}}}]}}}},"jsonVersion":2}})"};
+
+  auto cbor = nlohmann::json::to_cbor(nlohmann::json::parse(data));
+  string encoded(cbor.begin(), cbor.end());
+
+  for (const auto &doc : {data, encoded})
+  {
+    m_doc.emplace();
+    ASSERT_TRUE(ResponseDocument::parse(doc, *m_doc, m_context, "LinuxCNC"s));
+
+    ASSERT_EQ(5741581, m_doc->m_next);
+    ASSERT_EQ(1649989201, m_doc->m_instanceId);
+    ASSERT_EQ(2, m_doc->m_entities.size());
+
+    auto ent = m_doc->m_entities.begin();
+    ObservationPtr obs = dynamic_pointer_cast<Observation>(*ent);
+    ASSERT_EQ("v1", obs->get<string>("dataItemId"));
+    ASSERT_TRUE(obs->isUnavailable());
+
+    ent++;
+    ASSERT_EQ(4, (*ent)->get<int64_t>("count"));
+    const auto &ds = (*ent)->getValue<DataSet>();
+    ASSERT_EQ(4, ds.size());
+
+    auto dse = ds.begin();
+    ASSERT_EQ("X100", dse->m_key);
+    ASSERT_EQ(66, get<int64_t>(dse->m_value));
+    dse++;
+    ASSERT_EQ("ABC", get<string>(dse->m_value));
+    dse++;
+    ASSERT_EQ(44.6, get<double>(dse->m_value));
+    dse++;
+    ASSERT_EQ("X103", dse->m_key);
+    ASSERT_TRUE(dse->m_removed);
+  }
+}
+
+TEST_F(ResponseDocumentTest, should_parse_json_errors)
+{
+  string data {R"({"MTConnectError":{"Errors":[
+  {"Error":{"errorCode":"OUT_OF_RANGE","value":"'at' must be greater than 4871368"}},
+  {"Error":{"errorCode":"FAILURE","value":"Something went wrong"}}],
+  "Header":{"instanceId":1649989201},"jsonVersion":1}})"};
+
+  m_doc.emplace();
+  ASSERT_FALSE(ResponseDocument::parse(data, *m_doc, m_context));
+
+  ASSERT_EQ(2, m_doc->m_errors.size());
+  auto err = m_doc->m_errors.begin();
+  ASSERT_EQ("OUT_OF_RANGE", err->m_code);
+  ASSERT_EQ("'at' must be greater than 4871368", err->m_message);
+  err++;
+  ASSERT_EQ("FAILURE", err->m_code);
+}
@@ -20,8 +20,11 @@
 // Keep this comment to keep gtest.h above. (clang-format off/on is not working here!)
 
 #include <chrono>
+#include <fstream>
+#include <sstream>
 
 #include "entity/entity.hpp"
+#include "pipeline/char_scanner.hpp"
 #include "pipeline/shdr_tokenizer.hpp"
 #include "pipeline/timestamp_extractor.hpp"
 
@@ -55,6 +58,11 @@ inline std::list<std::string> extract(const Properties &props)
   return list;
 }
 
+inline std::list<std::string> strings(const TokenList &tokens)
+{
+  return std::list<string>(tokens.begin(), tokens.end());
+}
+
 template <typename T>
 inline bool isOfType(const EntityPtr &p)
 {
@@ -80,7 +88,7 @@ TEST_F(ShdrTokenizerTest, SimpleTokens)
     ASSERT_TRUE(entity);
     auto tokens = dynamic_pointer_cast<Tokens>(entity);
     ASSERT_TRUE(tokens);
-    EXPECT_EQ(test.second, tokens->m_tokens) << " given text: " << test.first;
+    EXPECT_EQ(test.second, strings(tokens->m_tokens)) << " given text: " << test.first;
   }
 }
 
@@ -143,6 +151,167 @@ TEST_F(ShdrTokenizerTest, escaped_line)
     ASSERT_TRUE(entity);
     auto tokens = dynamic_pointer_cast<Tokens>(entity);
     ASSERT_TRUE(tokens);
-    EXPECT_EQ(test.second, tokens->m_tokens) << " given text: " << test.first;
+    EXPECT_EQ(test.second, strings(tokens->m_tokens)) << " given text: " << test.first;
   }
 }
+
+TEST_F(ShdrTokenizerTest, should_refer_to_the_line_and_only_copy_escaped_fields)
+{
+  auto data = std::make_shared<entity::Entity>(
+      "Data", Properties {{"VALUE", R"(x|"a\|b"|y|"c\|d"|"plain")"s}});
+  auto entity = (*m_tokenizer)(data);
+  auto tokens = dynamic_pointer_cast<Tokens>(entity);
+  ASSERT_TRUE(tokens);
+
+  EXPECT_EQ((list<string> {"x", "a|b", "y", "c|d", "plain"}), strings(tokens->m_tokens));
+
+  auto &body = data->getValue<string>();
+  auto inBody = [&body](const string_view &view) {
+    return view.data() >= body.data() && view.data() < body.data() + body.size();
+  };
+
+  auto it = tokens->m_tokens.begin();
+  EXPECT_TRUE(inBody(*it++));
+  EXPECT_FALSE(inBody(*it++));
+  EXPECT_TRUE(inBody(*it++));
+  EXPECT_FALSE(inBody(*it++));
+  EXPECT_TRUE(inBody(*it++));
+
+  ASSERT_TRUE(tokens->m_owned);
+  EXPECT_EQ(2, tokens->m_owned->size());
+
+  // The original line is not modified by unescaping
+  EXPECT_EQ(R"(x|"a\|b"|y|"c\|d"|"plain")", body);
+}
+
+TEST_F(ShdrTokenizerTest, should_find_delimiters_the_same_as_a_scalar_scan)
+{
+  using Scanner = CharScanner<'|', '"', '\\'>;
+
+  // Place a delimiter at every offset across several 16 byte blocks
+  for (size_t len = 0; len < 70; len++)
+  {
+    for (size_t at = 0; at <= len; at++)
+    {
+      for (char c : {'|', '"', '\\'})
+      {
+        string buffer(len, 'x');
+        if (at < len)
+          buffer[at] = c;
+        auto b = buffer.data(), e = buffer.data() + buffer.size();
+        ASSERT_EQ(Scanner::findScalar(b, e), Scanner::find(b, e))
+            << "length " << len << " at " << at << " char " << c;
+        ASSERT_EQ(b + at, Scanner::find(b, e));
+      }
+    }
+  }
+
+  // High bit characters must not match
+  string utf8 = "\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9|";
+  auto b = utf8.data(), e = utf8.data() + utf8.size();
+  ASSERT_EQ(e - 1, Scanner::find(b, e));
+}
+
+TEST_F(ShdrTokenizerTest, should_find_the_same_delimiters_in_recorded_captures)
+{
+  for (auto file : {"/simulator/simple_scenario_1.txt", "/simulator/cuttingtool_scenario.txt"})
+  {
+    ifstream in(string(PROJECT_ROOT_DIR) + file);
+    ASSERT_TRUE(in.is_open()) << file;
+    stringstream ss;
+    ss << in.rdbuf();
+    auto buffer = ss.str();
+
+    using Scanner = CharScanner<'\n', '|', '"', '\\'>;
+    auto b = buffer.data(), e = buffer.data() + buffer.size();
+    auto p = b;
+    while (p < e)
+    {
+      auto q = Scanner::find(p, e);
+      p = Scanner::findScalar(p, e);
+      ASSERT_EQ(p - b, q - b);
+      if (p < e)
+        p++;
+    }
+
+    istringstream lines(buffer);
+    string line;
+    while (getline(lines, line))
+    {
+      if (line.empty())
+        continue;
+
+      Tokens result;
+      ShdrTokenizer::tokenize(line, result);
+      ASSERT_LT(1u, result.m_tokens.size()) << line;
+    }
+  }
+}
+
+// Run with --gtest_also_run_disabled_tests
+TEST_F(ShdrTokenizerTest, DISABLED_benchmark_delimiter_scanning)
+{
+  // Replay the recorded adapter captures until there is about a megabyte of SHDR
+  string capture;
+  for (auto file : {"/simulator/simple_scenario_1.txt", "/simulator/cuttingtool_scenario.txt"})
+  {
+    ifstream in(string(PROJECT_ROOT_DIR) + file);
+    ASSERT_TRUE(in.is_open()) << file;
+    stringstream ss;
+    ss << in.rdbuf();
+    capture += ss.str();
+  }
+
+  string buffer;
+  while (buffer.size() < 1024 * 1024)
+    buffer += capture;
+
+  list<string> lines;
+  {
+    istringstream in(buffer);
+    string line;
+    while (getline(in, line))
+      if (!line.empty())
+        lines.emplace_back(line);
+  }
+
+  using Scanner = CharScanner<'\n', '|', '"', '\\'>;
+  auto count = [&](auto find) {
+    size_t found = 0;
+    auto p = buffer.data(), e = buffer.data() + buffer.size();
+    while ((p = find(p, e)) < e)
+    {
+      found++;
+      p++;
+    }
+    return found;
+  };
+
+  auto start = chrono::steady_clock::now();
+  auto scalar = count(Scanner::findScalar);
+  auto scalarTime =
+      chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+  start = chrono::steady_clock::now();
+  auto simd = count(Scanner::find);
+  auto simdTime =
+      chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+  ASSERT_EQ(scalar, simd);
+
+  start = chrono::steady_clock::now();
+  size_t tokens = 0;
+  for (auto &line : lines)
+  {
+    Tokens result;
+    ShdrTokenizer::tokenize(line, result);
+    tokens += result.m_tokens.size();
+  }
+  auto tokenizeTime =
+      chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+  ASSERT_LT(lines.size(), tokens);
+
+  cout << "Scanned " << buffer.size() << " bytes, scalar: " << scalarTime.count()
+       << "us, simd: " << simdTime.count() << "us; tokenized " << lines.size()
+       << " lines in " << tokenizeTime.count() << "us" << endl;
+}
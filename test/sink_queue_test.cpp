@@ -0,0 +1,212 @@
+//
+// Copyright Copyright 2009-2022, AMT – The Association For Manufacturing Technology (“AMT”)
+// All rights reserved.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+// Ensure that gtest is the first header otherwise Windows raises an error
+#include <gtest/gtest.h>
+// Keep this comment to keep gtest.h above. (clang-format off/on is not working here!)
+
+#include <boost/asio/io_context.hpp>
+
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "device_model/data_item/data_item.hpp"
+#include "sink/sink_queue.hpp"
+
+using namespace std;
+using namespace std::literals;
+using namespace mtconnect;
+using namespace mtconnect::sink;
+using namespace mtconnect::observation;
+using namespace mtconnect::entity;
+using namespace mtconnect::device_model::data_item;
+
+class SinkQueueTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_a = makeDataItem("a");
+    m_b = makeDataItem("b");
+  }
+
+  DataItemPtr makeDataItem(const string &id)
+  {
+    ErrorList errors;
+    return DataItem::make({{"id", id}, {"type", "EXECUTION"s}, {"category", "EVENT"s}}, errors);
+  }
+
+  ObservationPtr observe(const DataItemPtr &di, const string &value)
+  {
+    ErrorList errors;
+    return Observation::make(di, {{"VALUE", value}}, chrono::system_clock::now(), errors);
+  }
+
+  SinkQueuePtr makeQueue(size_t capacity, SinkQueue::Policy policy)
+  {
+    return make_shared<SinkQueue>(
+        m_context,
+        [this](ObservationPtr &o) {
+          m_published.emplace_back(o->getDataItem()->getId() + "=" + o->getValue<string>());
+        },
+        capacity, policy);
+  }
+
+  boost::asio::io_context m_context;
+  vector<string> m_published;
+  DataItemPtr m_a, m_b;
+};
+
+TEST_F(SinkQueueTest, should_publish_on_the_sink_strand)
+{
+  auto queue = makeQueue(10, SinkQueue::BLOCK);
+
+  queue->push(observe(m_a, "1"));
+  queue->push(observe(m_b, "2"));
+  ASSERT_TRUE(m_published.empty());
+  ASSERT_EQ(2, queue->size());
+
+  m_context.run();
+
+  ASSERT_EQ((vector<string> {"a=1", "b=2"}), m_published);
+  ASSERT_EQ(0, queue->size());
+  ASSERT_EQ(2, queue->getHighWater());
+}
+
+TEST_F(SinkQueueTest, should_publish_inline_when_full_and_blocking)
+{
+  auto queue = makeQueue(2, SinkQueue::BLOCK);
+
+  for (int i = 1; i <= 5; i++)
+    queue->push(observe(m_a, to_string(i)));
+
+  ASSERT_EQ((vector<string> {"a=1", "a=2", "a=3", "a=4"}), m_published);
+
+  m_context.run();
+
+  ASSERT_EQ((vector<string> {"a=1", "a=2", "a=3", "a=4", "a=5"}), m_published);
+  ASSERT_EQ(0, queue->getDropped());
+  ASSERT_EQ(2, queue->getHighWater());
+}
+
+TEST_F(SinkQueueTest, should_drop_the_oldest_when_full)
+{
+  auto queue = makeQueue(2, SinkQueue::DROP);
+
+  for (int i = 1; i <= 5; i++)
+    queue->push(observe(m_a, to_string(i)));
+
+  m_context.run();
+
+  ASSERT_EQ((vector<string> {"a=4", "a=5"}), m_published);
+  ASSERT_EQ(3, queue->getDropped());
+}
+
+TEST_F(SinkQueueTest, should_coalesce_observations_for_the_same_data_item)
+{
+  auto queue = makeQueue(10, SinkQueue::COALESCE);
+
+  queue->push(observe(m_a, "1"));
+  queue->push(observe(m_b, "1"));
+  queue->push(observe(m_a, "2"));
+  queue->push(observe(m_a, "3"));
+
+  m_context.run();
+
+  ASSERT_EQ((vector<string> {"a=3", "b=1"}), m_published);
+  ASSERT_EQ(2, queue->getCoalesced());
+  ASSERT_EQ(0, queue->getDropped());
+}
+
+TEST_F(SinkQueueTest, should_count_dropped_and_coalesced_observations)
+{
+  auto drop = makeQueue(3, SinkQueue::DROP);
+  for (int i = 1; i <= 10; i++)
+    drop->push(observe(m_a, to_string(i)));
+
+  ASSERT_EQ(3, drop->size());
+  ASSERT_EQ(3, drop->getHighWater());
+  ASSERT_EQ(7, drop->getDropped());
+  ASSERT_EQ(0, drop->getCoalesced());
+
+  // Coalescing keeps one entry per data item, so nothing is dropped
+  auto coalesce = makeQueue(2, SinkQueue::COALESCE);
+  for (int i = 1; i <= 5; i++)
+  {
+    coalesce->push(observe(m_a, to_string(i)));
+    coalesce->push(observe(m_b, to_string(i)));
+  }
+
+  ASSERT_EQ(2, coalesce->size());
+  ASSERT_EQ(2, coalesce->getHighWater());
+  ASSERT_EQ(8, coalesce->getCoalesced());
+  ASSERT_EQ(0, coalesce->getDropped());
+
+  m_context.run();
+
+  // The counters are cumulative, draining only empties the queue
+  ASSERT_EQ(0, drop->size());
+  ASSERT_EQ(7, drop->getDropped());
+  ASSERT_EQ(0, coalesce->size());
+  ASSERT_EQ(8, coalesce->getCoalesced());
+  ASSERT_EQ((vector<string> {"a=8", "a=9", "a=10", "a=5", "b=5"}), m_published);
+}
+
+TEST_F(SinkQueueTest, should_discard_queued_observations_when_stopped)
+{
+  auto queue = makeQueue(10, SinkQueue::BLOCK);
+
+  queue->push(observe(m_a, "1"));
+  queue->stop();
+  ASSERT_FALSE(queue->push(observe(m_a, "2")));
+
+  m_context.run();
+
+  ASSERT_TRUE(m_published.empty());
+}
+
+TEST_F(SinkQueueTest, should_wait_for_a_publication_in_progress_when_stopped)
+{
+  promise<void> publishing, release;
+  auto blocked = release.get_future().share();
+  auto queue = make_shared<SinkQueue>(
+      m_context,
+      [&](ObservationPtr &o) {
+        m_published.emplace_back(o->getValue<string>());
+        publishing.set_value();
+        blocked.wait();
+      },
+      10, SinkQueue::BLOCK);
+
+  queue->push(observe(m_a, "1"));
+  queue->push(observe(m_a, "2"));
+
+  thread runner([this]() { m_context.run(); });
+  publishing.get_future().wait();
+
+  auto stopped = async(launch::async, [&queue]() { queue->stop(); });
+  EXPECT_EQ(future_status::timeout, stopped.wait_for(50ms));
+
+  release.set_value();
+  stopped.wait();
+  runner.join();
+
+  // The rest of the batch is not published once stopped
+  ASSERT_EQ((vector<string> {"1"}), m_published);
+  ASSERT_FALSE(queue->push(observe(m_a, "3")));
+}
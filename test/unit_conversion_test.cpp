@@ -91,3 +91,27 @@ TEST(UnitConversionTest, check_revolution_per_second)
   auto conv = UnitConversion::make("REVOLUTION/SECOND", "REVOLUTION/MINUTE");
   EXPECT_NEAR(420.0, conv->convert(7.0), 0.0001);
 }
+
+TEST(UnitConversionTest, should_convert_vectors_in_place_the_same_as_each_value)
+{
+  auto conv = UnitConversion::make("FAHRENHEIT", "CELSIUS");
+  ASSERT_TRUE(conv);
+
+  // Odd sizes exercise the scalar remainder
+  for (size_t size : {0, 1, 2, 3, 16, 1001})
+  {
+    Vector values;
+    for (size_t i = 0; i < size; i++)
+      values.push_back(i * 1.37 - 250.0);
+
+    auto copy = conv->convert(values);
+    conv->convert(values);
+    ASSERT_EQ(size, values.size());
+    for (size_t i = 0; i < size; i++)
+    {
+      double expected = conv->convert(i * 1.37 - 250.0);
+      ASSERT_EQ(expected, values[i]) << i;
+      ASSERT_EQ(expected, copy[i]) << i;
+    }
+  }
+}